@@ -45,6 +45,17 @@
 #include <string.h>
 
 #include "proj1timeconv.h"
+#include "proj1bufio.h"
+#include "proj1parallel.h"
+#include "proj1stats.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Number of values processed at once by process_sequence(). */
+#define BATCH_SIZE 1024
 
 
 /******************************************************************************
@@ -59,6 +70,18 @@
 typedef struct arguments {
   TE_Max_unit max_unit;   /* Maximum time unit. */
   bool extra;             /* Argument --extra? */
+  int threads;            /* Number of threads, -1 if not used. */
+  bool bin_in;            /* Argument --binary-in? */
+  bool bin_out;           /* Argument --binary-out? */
+  bool reverse;           /* Argument --reverse? */
+  bool stats;             /* Argument --stats or --stats-sketch? */
+  bool sketch;            /* Argument --stats-sketch? */
+  bool wide;              /* Argument --wide? */
+  bool follow;            /* Argument --follow? */
+  char *p_locale;         /* Code of language of the output or NULL. */
+
+  TF_Converter p_convert; /* Converter specialized for max_unit. */
+  TF_Sprinter p_sprint;   /* Printing specialized for max_unit. */
   
   char *p_fname_r;        /* Pointer to filename to read from. */
   char *p_fname_w;        /* Pointer to filename to write into. */
@@ -72,7 +95,13 @@ typedef struct arguments {
 
 int getargs(int argc, char *argv[], TS_Arguments *p_arg);
 
-int process_sequence(TE_Max_unit max_unit);
+int process_sequence(TS_Inbuffer *p_inbuff, TS_Arguments *p_args);
+
+int process_reverse(TS_Inbuffer *p_inbuff);
+
+int process_stats(TS_Inbuffer *p_inbuff, TS_Arguments *p_args);
+
+int process_wide(TS_Inbuffer *p_inbuff, TS_Arguments *p_args);
 
 void print_help(char *prog_name);
 
@@ -100,6 +129,25 @@ int getargs(int argc, char *argv[], TS_Arguments *p_args)
   /* No extra used yet - initialization for portability. */
   p_args->extra = false;
 
+  p_args->threads = -1;   /* Sequential processing by default. */
+
+  p_args->bin_in = false; /* Text input and output by default. */
+  p_args->bin_out = false;
+
+  p_args->reverse = false;  /* Conversion from seconds by default. */
+
+  p_args->stats = false;    /* Printing of every value by default. */
+  p_args->sketch = false;
+
+  p_args->wide = false;     /* Values up to ULONG_MAX by default. */
+
+  p_args->follow = false;   /* Processing ends at the end of input. */
+
+  p_args->p_locale = NULL;  /* Czech output by default. */
+
+  p_args->p_convert = NULL; /* Selected after the max_unit is known. */
+  p_args->p_sprint = NULL;
+
   if (argc == 1) {      /* Setting default value when no arguments were used. */
     p_args->max_unit = WEEKS;
   }
@@ -118,6 +166,49 @@ int getargs(int argc, char *argv[], TS_Arguments *p_args)
       if ((strcmp("--extra", argv[i])) == 0) {    /* Optional EXTRA argument. */
         p_args->extra = true;
       }
+      else if ((strcmp("--binary-in", argv[i])) == 0) {   /* Binary input. */
+        p_args->bin_in = true;
+      }
+      else if ((strcmp("--binary-out", argv[i])) == 0) {  /* Binary output. */
+        p_args->bin_out = true;
+      }
+      else if ((strcmp("--reverse", argv[i])) == 0) {     /* Reverse. */
+        p_args->reverse = true;
+      }
+      else if ((strcmp("--follow", argv[i])) == 0) {      /* Following. */
+        p_args->follow = true;
+      }
+      else if ((strcmp("--wide", argv[i])) == 0) {        /* Any size. */
+        p_args->wide = true;
+      }
+      else if ((strcmp("--stats", argv[i])) == 0) {       /* Statistics. */
+        p_args->stats = true;
+      }
+      else if ((strcmp("--stats-sketch", argv[i])) == 0) {
+        p_args->stats = true;                     /* Approximated statistics. */
+        p_args->sketch = true;
+      }
+      else if ((strcmp("--threads", argv[i])) == 0 && p_args->threads == -1
+               && (i + 1) < argc) {               /* Optional threads. */
+        i++;
+
+        char *endptr = NULL;
+        errno = ESUCCESS;
+        long threads = strtol(argv[i], &endptr, 10);
+
+        if (errno != ESUCCESS || *endptr != '\0' || endptr == argv[i]
+            || threads < 0 || threads > MAX_THREADS) {
+          errno = EINVAL;
+          return EXIT_FAILURE;
+        }
+
+        p_args->threads = (int) threads;
+      }
+      else if ((strcmp("--locale", argv[i])) == 0 && p_args->p_locale == NULL
+               && (i + 1) < argc) {               /* Language of output. */
+        i++;
+        p_args->p_locale = argv[i];
+      }
       else if ((strcmp("-fr", argv[i])) == 0 && p_args->p_fname_r == NULL
                && (i + 1) < argc) {               /* Optional input file. */
         i++;
@@ -170,9 +261,56 @@ int getargs(int argc, char *argv[], TS_Arguments *p_args)
     /*
      * If there was no --extra argument and any of the pointer are not NULL,
      * then sets errno, because file I/O can be used only with --extra argument.
+     * Same applies for --threads, binary I/O, --reverse, --stats, --wide,
+     * --follow and --locale arguments.
      */
     if (p_args->extra == false && (p_args->p_fname_r != NULL ||
-        p_args->p_fname_w != NULL || p_args->p_fname_a != NULL)) {
+        p_args->p_fname_w != NULL || p_args->p_fname_a != NULL
+        || p_args->threads != -1 || p_args->bin_in || p_args->bin_out
+        || p_args->reverse || p_args->stats || p_args->wide
+        || p_args->follow || p_args->p_locale != NULL)) {
+      errno = EINVAL;
+      return EXIT_FAILURE;
+    }
+
+    /*
+     * Reverse conversion is processed only sequentially and as text, and it
+     * reads only Czech names of units.
+     */
+    if (p_args->reverse && (p_args->threads != -1 || p_args->bin_in
+                            || p_args->bin_out || p_args->p_locale != NULL)) {
+      errno = EINVAL;
+      return EXIT_FAILURE;
+    }
+
+    /* Only text lines of input file can be followed and converted. */
+    if (p_args->follow && (p_args->p_fname_r == NULL || p_args->threads != -1
+                           || p_args->bin_in || p_args->reverse
+                           || p_args->stats || p_args->wide)) {
+      errno = EINVAL;
+      return EXIT_FAILURE;
+    }
+
+    /* Values of any size are only read and printed as text sequentially. */
+    if (p_args->wide && (p_args->threads != -1 || p_args->bin_in
+                         || p_args->bin_out || p_args->reverse
+                         || p_args->stats)) {
+      errno = EINVAL;
+      return EXIT_FAILURE;
+    }
+
+    /*
+     * Statistics are computed only sequentially and printed as text, and
+     * their labels are only Czech.
+     */
+    if (p_args->stats && (p_args->threads != -1 || p_args->bin_out
+                          || p_args->reverse || p_args->p_locale != NULL)) {
+      errno = EINVAL;
+      return EXIT_FAILURE;
+    }
+
+    /* Binary input and output are processed only sequentially. */
+    if (p_args->threads != -1 && (p_args->bin_in || p_args->bin_out)) {
       errno = EINVAL;
       return EXIT_FAILURE;
     }
@@ -189,6 +327,23 @@ int getargs(int argc, char *argv[], TS_Arguments *p_args)
     /* Testing for only EXTRA argument. If so, then sets to default value. */
     if (p_args->max_unit == NOT_DEF && p_args->extra == true)
       p_args->max_unit = WEEKS;
+
+    /*
+     * Names of units of selected language are prepared once, before any value
+     * is printed.
+     */
+    if (p_args->p_locale != NULL
+        && select_locale(p_args->p_locale) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+  }
+
+  /*
+   * Selection of functions specialized for max_unit, so it's not tested for
+   * every processed value.
+   */
+  if (p_args->max_unit >= SECONDS && p_args->max_unit <= WEEKS) {
+    p_args->p_convert = select_converter(p_args->max_unit);
+    p_args->p_sprint = select_sprinter(p_args->max_unit);
   }
 
   return EXIT_SUCCESS;
@@ -196,29 +351,93 @@ int getargs(int argc, char *argv[], TS_Arguments *p_args)
 
 
 /**
- * Function processes possible endless sequence of numbers from stdin and prints
- * processed values to stdout, if there was no error.
+ * Function processes possible endless sequence of numbers from given input
+ * buffer (stdin or file) and prints processed values to stdout, if there was
+ * no error. Input is read and output is written in large blocks (see
+ * proj1bufio.c module), the output is flushed also before returning upon error.
+ * Numbers are read as text lines or as binary values (--binary-in) and the
+ * results are printed as text or as binary records (--binary-out). When the
+ * file is followed (--follow), the batch ends also with the last buffered
+ * line and the output is flushed after every batch, so the converted values
+ * are printed before waiting for appended lines.
  */
-int process_sequence(TE_Max_unit max_unit)
+int process_sequence(TS_Inbuffer *p_inbuff, TS_Arguments *p_args)
 {
-  TS_Time time;             /* Structure for saving processed value of time. */
+  /* Reading and printing functions given by arguments. */
+  int (*p_read)(TS_Inbuffer *, unsigned long *) = breadtoul;
+  int (*p_print)(TS_Outbuffer *, TS_Time *) = bprint_time_value;
+
+  TS_Time times[BATCH_SIZE];            /* Processed values of time. */
 
-  unsigned long seconds;    /* Variable for storing value of input number. */
+  unsigned long seconds[BATCH_SIZE];    /* Values of input numbers. */
+
+  size_t count = 0;         /* Number of values in actual batch. */
+
+  TS_Outbuffer outbuff;     /* Buffer for block writing to stdout. */
 
   int ret_val;              /* Return value of called function. */
 
+  int errno_bak;            /* Backup of errno while flushing the output. */
+
+
+  if (p_args->bin_in == true)
+    p_read = breadu64;
+
+  if (p_args->bin_out == true)
+    p_print = bwrite_time_value;
+
+  if (outbuff_init(&outbuff, stdout) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  outbuff.p_sprint = p_args->p_sprint;
 
   /*
-   * Processes the time value and prints it to stdout, if there was no error
-   * while transforming the number to value.
+   * Reads values into batch until it's full or there's nothing more to read,
+   * then processes the whole batch at once and stores it to the output buffer.
+   * The values read before an error are processed too.
    */
-  while ((ret_val = readtoul(&seconds)) == EXIT_SUCCESS) {
+  do {
+    count = 0;
+
+    while (count < BATCH_SIZE
+           && (ret_val = p_read(p_inbuff, &seconds[count])) == EXIT_SUCCESS) {
+      count++;
+
+      if (p_args->follow == true && inbuff_has_line(p_inbuff) == false)
+        break;              /* Next reading could wait for appended lines. */
+    }
+
+    errno_bak = errno;
 
-    time = process_time_value(seconds, max_unit);
+    p_args->p_convert(seconds, times, count);
+
+    for (size_t i = 0; i < count; i++) {
+      if (p_print(&outbuff, &times[i]) == EXIT_FAILURE) {
+        errno_bak = errno;
+        ret_val = EXIT_FAILURE;
+        break;
+      }
+    }
+
+    /* Flushing of whole batch, when following the file. */
+    if (p_args->follow == true && ret_val == EXIT_SUCCESS
+        && (outbuff_flush(&outbuff) == EXIT_FAILURE || fflush(stdout) == EOF)) {
+      errno_bak = errno;
+      ret_val = EXIT_FAILURE;
+    }
 
-    print_time_value(&time);
+  } while (ret_val == EXIT_SUCCESS);
+
+  /* Printing of values processed before the end of input or an error. */
+  if (outbuff_flush(&outbuff) == EXIT_FAILURE && ret_val != EXIT_FAILURE) {
+    errno_bak = errno;
+    ret_val = EXIT_FAILURE;
   }
 
+  outbuff_free(&outbuff);
+
+  errno = errno_bak;
+
   if (ret_val == EOF)       /* No error while processing a value from stdin. */
     return EXIT_SUCCESS;
   else
@@ -226,6 +445,157 @@ int process_sequence(TE_Max_unit max_unit)
 }
 
 
+/**
+ * Function processes possible endless sequence of time values in Czech form
+ * from given input buffer (--reverse) and prints the corresponding numbers of
+ * seconds to stdout, one per line. It is reverse of process_sequence() and it
+ * behaves same way - output is written in large blocks, the values read before
+ * an error are printed and empty line ends the processing.
+ */
+int process_reverse(TS_Inbuffer *p_inbuff)
+{
+  TS_Outbuffer outbuff;     /* Buffer for block writing to stdout. */
+
+  unsigned long seconds;    /* Actual converted value. */
+
+  int ret_val;              /* Return value of called function. */
+
+  int errno_bak;            /* Backup of errno while flushing the output. */
+
+
+  if (outbuff_init(&outbuff, stdout) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  while ((ret_val = breadtime(p_inbuff, &seconds)) == EXIT_SUCCESS) {
+    if (bprint_ul(&outbuff, &seconds) == EXIT_FAILURE) {
+      ret_val = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  errno_bak = errno;
+
+  /* Printing of values processed before the end of input or an error. */
+  if (outbuff_flush(&outbuff) == EXIT_FAILURE && ret_val != EXIT_FAILURE) {
+    errno_bak = errno;
+    ret_val = EXIT_FAILURE;
+  }
+
+  outbuff_free(&outbuff);
+
+  errno = errno_bak;
+
+  if (ret_val == EOF)       /* No error while processing a value. */
+    return EXIT_SUCCESS;
+  else
+    return EXIT_FAILURE;    /* An error occurred, the errno is set. */
+}
+
+
+/**
+ * Function reads possible endless sequence of numbers from given input buffer
+ * (as text lines or binary values, same as process_sequence()) and prints only
+ * their statistics to stdout (--stats). See proj1stats.c module for more
+ * information. Statistics of the values read before an error are printed too.
+ */
+int process_stats(TS_Inbuffer *p_inbuff, TS_Arguments *p_args)
+{
+  /* Reading function given by arguments. */
+  int (*p_read)(TS_Inbuffer *, unsigned long *) = breadtoul;
+
+  unsigned long seconds[BATCH_SIZE];    /* Values of input numbers. */
+
+  size_t count = 0;         /* Number of values in actual batch. */
+
+  TS_Stats stats;           /* Statistics of read values. */
+
+  int ret_val;              /* Return value of called function. */
+
+  int errno_bak;            /* Backup of errno while printing. */
+
+
+  if (p_args->bin_in == true)
+    p_read = breadu64;
+
+  if (stats_init(&stats, p_args->max_unit, p_args->sketch) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  do {
+    count = 0;
+
+    while (count < BATCH_SIZE
+           && (ret_val = p_read(p_inbuff, &seconds[count])) == EXIT_SUCCESS)
+      count++;
+
+    errno_bak = errno;
+
+    if (stats_add(&stats, seconds, count) == EXIT_FAILURE) {
+      errno_bak = errno;
+      ret_val = EXIT_FAILURE;
+    }
+
+  } while (ret_val == EXIT_SUCCESS);
+
+  stats_print(&stats);
+  stats_free(&stats);
+
+  errno = errno_bak;
+
+  if (ret_val == EOF)       /* No error while processing a value. */
+    return EXIT_SUCCESS;
+  else
+    return EXIT_FAILURE;    /* An error occurred, the errno is set. */
+}
+
+
+/**
+ * Same function as process_sequence(), but the numbers of seconds can be of
+ * any size (--wide). Every input line is converted by sprint_time_decimal().
+ */
+int process_wide(TS_Inbuffer *p_inbuff, TS_Arguments *p_args)
+{
+  TS_Outbuffer outbuff;     /* Buffer for block writing to stdout. */
+
+  const char *p_digits;     /* Digits of actual number. */
+
+  size_t length;            /* Number of digits. */
+
+  int ret_val;              /* Return value of called function. */
+
+  int errno_bak;            /* Backup of errno while flushing the output. */
+
+
+  if (outbuff_init(&outbuff, stdout) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  while ((ret_val = breaddigits(p_inbuff, &p_digits, &length))
+         == EXIT_SUCCESS) {
+    if (bprint_time_decimal(&outbuff, p_digits, length, p_args->max_unit)
+        == EXIT_FAILURE) {
+      ret_val = EXIT_FAILURE;
+      break;
+    }
+  }
+
+  errno_bak = errno;
+
+  /* Printing of values processed before the end of input or an error. */
+  if (outbuff_flush(&outbuff) == EXIT_FAILURE && ret_val != EXIT_FAILURE) {
+    errno_bak = errno;
+    ret_val = EXIT_FAILURE;
+  }
+
+  outbuff_free(&outbuff);
+
+  errno = errno_bak;
+
+  if (ret_val == EOF)       /* No error while processing a value. */
+    return EXIT_SUCCESS;
+  else
+    return EXIT_FAILURE;    /* An error occurred, the errno is set. */
+}
+
+
 /**
  * Displays help page about how to use this program.
  */
@@ -235,8 +605,8 @@ void print_help(char *prog_name)
   "Usage: %s [OPTION]... \n"
   "\n"
   "Transforms NUMBER of seconds to human-readable form from standard input to\n"
-  "standard output. The output is in Czech language. The type of NUMBER is\n"
-  "unsigned long integer.\n"
+  "standard output. The output is in Czech language (see --locale). The type\n"
+  "of NUMBER is unsigned long integer.\n"
   "\n"
   "  -s                       maximal displayed units - seconds\n"
   "  -m                       maximal displayed units - minutes\n"
@@ -252,11 +622,39 @@ void print_help(char *prog_name)
   "  -fr [FILE]               reads input from FILE\n"
   "  -fw [FILE]               writes output to FILE, overwrites existing file\n"
   "  -fa [FILE]               appends output to FILE, do not overwrites\n"
+  "      --threads [N]        converts input lines by N threads, 0 stands for\n"
+  "                           number of processors (up to 64)\n"
+  "      --binary-in          reads NUMBERs as little-endian 64 bit unsigned\n"
+  "                           integers instead of text lines\n"
+  "      --binary-out         writes records of weeks, days, hours, minutes\n"
+  "                           and seconds, every as little-endian 64 bit\n"
+  "                           unsigned integer, instead of text\n"
+  "      --reverse            reads time values in Czech form (as printed by\n"
+  "                           this program) and writes NUMBERs of seconds\n"
+  "      --locale [LANG]      prints names of units in language LANG - cs\n"
+  "                           (default), sk, en or de\n"
+  "      --follow             keeps reading FILE given by -fr after its' end\n"
+  "                           and converts appended lines, until an empty\n"
+  "                           line is read (Linux only)\n"
+  "      --wide               accepts NUMBERs of any size, not only unsigned\n"
+  "                           long integers\n"
+  "      --stats              prints only count, total, minimum, maximum,\n"
+  "                           mean, 50th, 90th and 99th percentile and the\n"
+  "                           numbers of values by their highest unit\n"
+  "      --stats-sketch       same as --stats, but the percentiles are\n"
+  "                           approximated (error below 1 %%) in constant\n"
+  "                           memory\n"
   "      --extra              enables processing of possible endless sequence\n"
   "                           of input lines\n"
   "\n"
   "Option --extra can be combined with one [ -s | -m | -h | -d | -t ] option\n"
-  "for specifying the maximal displayed units when using --extra.\n"
+  "for specifying the maximal displayed units when using --extra. Binary\n"
+  "input and output can't be combined with --threads, --reverse can't be\n"
+  "combined with --threads, --locale nor with binary input and output.\n"
+  "Statistics can't be combined with --threads, --reverse, --locale nor\n"
+  "--binary-out, --wide can't be combined with --threads, --reverse, binary\n"
+  "input and output nor statistics. --follow requires -fr and can be\n"
+  "combined only with --binary-out and --locale.\n"
   "\n"
   "Examples:\n"
   "  %s --extra -d\n"
@@ -348,9 +746,22 @@ int main(int argc, char *argv[])
   }
   else {
     
-    /* Redirecting input stream from a given file name. */
-    if (args.p_fname_r != NULL
-        && freopen(args.p_fname_r, "r", stdin) == NULL) {
+    TS_Inbuffer inbuff;       /* Buffer for reading of input values. */
+
+    int ret_val;              /* Return value of processing. */
+
+    /*
+     * Opening input file of a given name, which is followed (--follow) or
+     * memory-mapped if possible, or using stdin.
+     */
+    if (args.p_fname_r != NULL && args.follow == true)
+      ret_val = inbuff_follow(&inbuff, args.p_fname_r);
+    else if (args.p_fname_r != NULL)
+      ret_val = inbuff_open(&inbuff, args.p_fname_r);
+    else
+      ret_val = inbuff_init(&inbuff, stdin);
+
+    if (ret_val == EXIT_FAILURE) {
       perror("proj1: Error");
       return EXIT_FAILURE;      
     }
@@ -359,6 +770,7 @@ int main(int argc, char *argv[])
     if (args.p_fname_w != NULL
         && freopen(args.p_fname_w, "w", stdout) == NULL) {
       perror("proj1: Error");
+      inbuff_free(&inbuff);
       return EXIT_FAILURE;
     }
     
@@ -371,19 +783,57 @@ int main(int argc, char *argv[])
     if (args.p_fname_a != NULL
         && freopen(args.p_fname_a, "a", stdout) == NULL) {
       perror("proj1: Error");
+      inbuff_free(&inbuff);
       return EXIT_FAILURE;
     }
     
     /*
      * Processing possible endless sequence of input values by calling
      * process_sequence() function. For more information see the description of
-     * the process_sequence() function.
+     * the process_sequence() function. When --threads was used, the input is
+     * processed by process_sequence_mt() function instead, which reports also
+     * the line of error.
      */
-    if (process_sequence(args.max_unit) == EXIT_FAILURE) {
-      perror("proj1: Error");
-      return EXIT_FAILURE;
+    if (args.wide == true) {
+      ret_val = process_wide(&inbuff, &args);
+
+      if (ret_val == EXIT_FAILURE)
+        perror("proj1: Error");
+    }
+    else if (args.stats == true) {
+      ret_val = process_stats(&inbuff, &args);
+
+      if (ret_val == EXIT_FAILURE)
+        perror("proj1: Error");
     }
+    else if (args.reverse == true) {
+      ret_val = process_reverse(&inbuff);
 
+      if (ret_val == EXIT_FAILURE)
+        perror("proj1: Error");
+    }
+    else if (args.threads != -1) {
+      unsigned long line;
+
+      ret_val = process_sequence_mt(&inbuff, stdout, args.max_unit,
+                                    args.threads, &line);
+
+      if (ret_val == EXIT_FAILURE && line != 0)
+        fprintf(stderr, "proj1: Error: Line %lu: %s\n", line, strerror(errno));
+      else if (ret_val == EXIT_FAILURE)
+        perror("proj1: Error");
+    }
+    else {
+      ret_val = process_sequence(&inbuff, &args);
+
+      if (ret_val == EXIT_FAILURE)
+        perror("proj1: Error");
+    }
+
+    inbuff_free(&inbuff);
+
+    if (ret_val == EXIT_FAILURE)
+      return EXIT_FAILURE;
   }
   
   return EXIT_SUCCESS;
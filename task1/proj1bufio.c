@@ -0,0 +1,903 @@
+/**
+ * File:          proj1bufio.c
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This module contains functions for block reading and writing
+ *                of time values. It is used by proj1.c module for processing
+ *                of possible endless sequence of input values (--extra), where
+ *                per character reading by fgetc() and formatted printing of
+ *                every value would be too slow.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1BUFIO.C ]**************************************************
+ ******************************************************************************/
+
+/* Needed for mmap(), fstat() and fdopen() with -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+/* Following of growing file (--follow) is supported only on Linux. */
+#ifdef __linux__
+  #define BUFIO_INOTIFY
+#endif
+
+/******************************************************************************
+ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef BUFIO_INOTIFY
+  #include <sys/inotify.h>
+#endif
+
+#include "proj1timeconv.h"
+#include "proj1bufio.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Size of input and output buffers. */
+static const size_t BUFF_SIZE_DEF = 262144;
+
+/*
+ * Number of digits, which can be always stored in unsigned long without the
+ * overflow testing. (Maximal value of this number of digits is lower than
+ * ULONG_MAX / 10.)
+ */
+#if ULONG_MAX > 0xFFFFFFFFUL
+  static const int SAFE_DIGITS = 18;
+#else
+  static const int SAFE_DIGITS = 8;
+#endif
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+static size_t inbuff_fill(TS_Inbuffer *p_inbuff);
+
+static int inbuff_wait(TS_Inbuffer *p_inbuff);
+
+static size_t inbuff_more(TS_Inbuffer *p_inbuff);
+
+static int inbuff_line(TS_Inbuffer *p_inbuff, const char **pp_line,
+                       size_t *p_length);
+
+static int outbuff_ext(TS_Outbuffer *p_outbuff);
+
+static int outbuff_reserve(TS_Outbuffer *p_outbuff, size_t n);
+
+static inline unsigned char *u64tole(unsigned long long value,
+                                     unsigned char *p_dest);
+
+
+/******************************************************************************
+ ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Same function as readtoul(), but it reads the digits from given input buffer,
+ * which is refilled by blocks from its' stream when needed. Return values and
+ * errno settings are same as of readtoul() function. Only one test is performed
+ * for every character and the overflow testing is performed only for digits,
+ * which can overflow.
+ */
+int breadtoul(TS_Inbuffer *p_inbuff, unsigned long *p_num)
+{
+  /* Helpful values for overflow testing, same as in readtoul(). */
+  const unsigned long max_val_quo = ULONG_MAX / 10;
+  const unsigned long max_val_rem = ULONG_MAX % 10;
+
+  unsigned long num = 0;              /* Actual value of reading. */
+
+  int i = 0;                          /* Number of read digits. */
+
+  errno = ESUCCESS;                   /* Setting errno to 0 for use below. */
+
+
+  while (p_inbuff->pos < p_inbuff->used || inbuff_fill(p_inbuff) > 0) {
+
+    const unsigned char *p_act = (unsigned char *) p_inbuff->p_data
+                                 + p_inbuff->pos;
+    const unsigned char *p_end = (unsigned char *) p_inbuff->p_data
+                                 + p_inbuff->used;
+
+    /*
+     * Processing of digits available in buffer. Non-digit characters are
+     * bigger than 9 after subtraction thanks to unsigned arithmetic.
+     */
+    while (p_act < p_end) {
+
+      unsigned long digit = (unsigned long) (*p_act - '0');
+
+      if (digit > 9)
+        break;
+
+      if (i >= SAFE_DIGITS
+          && (num > max_val_quo
+              || (num == max_val_quo && digit > max_val_rem))) {
+        p_inbuff->pos = (size_t) (p_act - (unsigned char *) p_inbuff->p_data);
+        *p_num = num;
+        errno = EOVERFLOW;  /* Value too big to be stored in given type. */
+        return EXIT_FAILURE;
+      }
+
+      num = num * 10 + digit;
+      i++;
+      p_act++;
+    }
+
+    p_inbuff->pos = (size_t) (p_act - (unsigned char *) p_inbuff->p_data);
+
+    /* Was the processing stopped by non-digit character? */
+    if (p_act < p_end) {
+
+      *p_num = num;
+
+      if (*p_act != '\n') {
+        errno = EDOM;       /* Invalid character was read. */
+        return EXIT_FAILURE;
+      }
+
+      p_inbuff->pos++;      /* Skipping the end of line. */
+      break;
+    }
+  }
+
+  *p_num = num;
+
+  /* Error upon reading of the stream? */
+  if (p_inbuff->f_stream != NULL && ferror(p_inbuff->f_stream)
+      && errno != ESUCCESS)
+    return EXIT_FAILURE;
+  else if (i == 0)
+    return EOF;             /* No reading was performed. */
+  else
+    return EXIT_SUCCESS;    /* Reading proceed without error. */
+}
+
+
+/**
+ * Same function as print_time_value(), but it stores the value into given
+ * output buffer by its' p_sprint function, which is flushed into its' stream
+ * when there's no space left for another value. (Buffer without stream is
+ * extended instead.) Returns
+ * EXIT_SUCCESS or EXIT_FAILURE and sets errno, if the flushing or extending of
+ * the buffer has failed.
+ */
+int bprint_time_value(TS_Outbuffer *p_outbuff, TS_Time *p_time)
+{
+  if (outbuff_reserve(p_outbuff, MAX_TIME_STR) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  int length = p_outbuff->p_sprint(p_outbuff->p_data + p_outbuff->used,
+                                   p_time);
+
+  p_outbuff->used += (size_t) length;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Binary version of breadtoul() function. It reads one little-endian 64 bit
+ * unsigned integer from given input buffer. Returns EOF if there was no input,
+ * EXIT_SUCCESS if everything went fine and EXIT_FAILURE if there was an error.
+ * The errno is set to EDOM for incomplete value at the end of input and to
+ * EOVERFLOW for value, which can't be stored in unsigned long.
+ */
+int breadu64(TS_Inbuffer *p_inbuff, unsigned long *p_num)
+{
+  unsigned char bytes[BIN_VALUE_SIZE];  /* Bytes of the value. */
+
+  unsigned long long value = 0;         /* Decoded value. */
+
+  size_t got = 0;                       /* Number of read bytes. */
+  size_t take;                          /* Bytes taken from buffer at once. */
+
+  errno = ESUCCESS;
+
+  /* The value can be split between two blocks of the stream. */
+  while (got < BIN_VALUE_SIZE) {
+
+    if (p_inbuff->pos == p_inbuff->used && inbuff_fill(p_inbuff) == 0)
+      break;
+
+    take = p_inbuff->used - p_inbuff->pos;
+
+    if (take > BIN_VALUE_SIZE - got)
+      take = BIN_VALUE_SIZE - got;
+
+    memcpy(bytes + got, p_inbuff->p_data + p_inbuff->pos, take);
+
+    p_inbuff->pos += take;
+    got += take;
+  }
+
+  if (p_inbuff->f_stream != NULL && ferror(p_inbuff->f_stream)
+      && errno != ESUCCESS)
+    return EXIT_FAILURE;      /* Error upon reading of the stream. */
+  else if (got == 0)
+    return EOF;               /* No reading was performed. */
+  else if (got < BIN_VALUE_SIZE) {
+    errno = EDOM;             /* Incomplete value. */
+    return EXIT_FAILURE;
+  }
+
+  /* Little-endian decoding, independent on the byte order of processor. */
+  for (int i = BIN_VALUE_SIZE - 1; i >= 0; i--)
+    value = (value << CHAR_BIT) | bytes[i];
+
+#if ULONG_MAX < ULLONG_MAX
+  if (value > ULONG_MAX) {
+    errno = EOVERFLOW;        /* Value too big to be stored in given type. */
+    return EXIT_FAILURE;
+  }
+#endif
+
+  *p_num = (unsigned long) value;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Binary version of bprint_time_value() function. It stores the content of
+ * given TS_Time structure into the output buffer as a record of BIN_RECORD_SIZE
+ * bytes: weeks, days, hours, minutes and seconds, every as little-endian 64 bit
+ * unsigned integer. Returns EXIT_SUCCESS or EXIT_FAILURE and sets errno, if the
+ * flushing or extending of the buffer has failed.
+ */
+int bwrite_time_value(TS_Outbuffer *p_outbuff, TS_Time *p_time)
+{
+  if (outbuff_reserve(p_outbuff, MAX_TIME_STR) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  unsigned char *p_dest = (unsigned char *) p_outbuff->p_data
+                          + p_outbuff->used;
+
+  p_dest = u64tole(p_time->weeks, p_dest);
+  p_dest = u64tole(p_time->days, p_dest);
+  p_dest = u64tole(p_time->hours, p_dest);
+  p_dest = u64tole(p_time->mins, p_dest);
+  u64tole(p_time->secs, p_dest);
+
+  p_outbuff->used += BIN_RECORD_SIZE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Reverse version of breadtoul() function. It reads one line containing time
+ * value in Czech form (as printed by bprint_time_value()) from given input
+ * buffer and converts it back to number of seconds by scan_time_value(). The
+ * line is parsed straight in the buffer. Returns EOF if there was no input,
+ * EXIT_SUCCESS if everything went fine and EXIT_FAILURE if there was an error.
+ * The errno is set by scan_time_value() or upon reading error.
+ */
+int breadtime(TS_Inbuffer *p_inbuff, unsigned long *p_num)
+{
+  const char *p_line;       /* Read line. */
+
+  size_t length;            /* Length of the line without '\n'. */
+
+  int ret_val = inbuff_line(p_inbuff, &p_line, &length);
+
+  if (ret_val != EXIT_SUCCESS)
+    return ret_val;
+
+  return scan_time_value(p_line, length, p_num);
+}
+
+
+/**
+ * Stores given number of seconds into the output buffer as decimal number
+ * terminated by '\n'. Its' interface is same as of bprint_time_value(), so
+ * both can be used by same caller. Returns EXIT_SUCCESS or EXIT_FAILURE and
+ * sets errno, if the flushing or extending of the buffer has failed.
+ */
+int bprint_ul(TS_Outbuffer *p_outbuff, unsigned long *p_num)
+{
+  if (outbuff_reserve(p_outbuff, MAX_TIME_STR) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  char *p_end = ultostr(*p_num, p_outbuff->p_data + p_outbuff->used);
+
+  *p_end++ = '\n';
+
+  p_outbuff->used = (size_t) (p_end - p_outbuff->p_data);
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Reads one line of decimal digits of any length from given input buffer for
+ * the wide conversion (see sprint_time_decimal()). The pointer to the digits
+ * (valid until next reading) and their number are stored by given pointers.
+ * Returns EOF if there was no input, EXIT_SUCCESS if everything went fine and
+ * EXIT_FAILURE if there was an error. The errno is set to EDOM for invalid
+ * character or upon reading error.
+ */
+int breaddigits(TS_Inbuffer *p_inbuff, const char **pp_digits,
+                size_t *p_length)
+{
+  int ret_val = inbuff_line(p_inbuff, pp_digits, p_length);
+
+  if (ret_val != EXIT_SUCCESS)
+    return ret_val;
+
+  for (size_t i = 0; i < *p_length; i++) {
+    if ((unsigned char) ((*pp_digits)[i] - '0') > 9) {
+      errno = EDOM;         /* Invalid character was read. */
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Same function as bprint_time_value(), but the number of seconds of any size
+ * is given as string of length decimal digits and it's converted by
+ * sprint_time_decimal() with given max_unit. Returns EXIT_SUCCESS or
+ * EXIT_FAILURE and sets errno, if the flushing or extending of the buffer has
+ * failed.
+ */
+int bprint_time_decimal(TS_Outbuffer *p_outbuff, const char *p_digits,
+                        size_t length, TE_Max_unit max_unit)
+{
+  if (outbuff_reserve(p_outbuff, length + MAX_TIME_STR) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  p_outbuff->used += sprint_time_decimal(p_outbuff->p_data + p_outbuff->used,
+                                         p_digits, length, max_unit);
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the input buffer for given stream. Returns EXIT_FAILURE
+ * and sets errno to ENOMEM, if the memory allocation has failed.
+ */
+int inbuff_init(TS_Inbuffer *p_inbuff, FILE *f_stream)
+{
+  /* Buffer values initialization. */
+  p_inbuff->f_stream = f_stream;
+  p_inbuff->size = 0;
+  p_inbuff->used = 0;
+  p_inbuff->pos = 0;
+  p_inbuff->eof = false;
+  p_inbuff->mapped = false;
+  p_inbuff->opened = false;
+  p_inbuff->watch_fd = -1;
+
+  /* Buffer memory allocation. */
+  p_inbuff->p_data = (char *) malloc(BUFF_SIZE_DEF * sizeof(char));
+
+  if (p_inbuff->p_data == NULL) {   /* Memory allocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_inbuff->size = BUFF_SIZE_DEF;   /* New size of buffer. */
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the input buffer over given memory, which already contains
+ * all the data. No stream is used and nothing is allocated, so the buffer
+ * doesn't have to be disposed of.
+ */
+void inbuff_mem(TS_Inbuffer *p_inbuff, char *p_data, size_t size)
+{
+  p_inbuff->f_stream = NULL;
+  p_inbuff->size = size;
+  p_inbuff->used = size;
+  p_inbuff->pos = 0;
+  p_inbuff->eof = true;         /* There's nothing more to read. */
+  p_inbuff->mapped = false;
+  p_inbuff->opened = false;
+  p_inbuff->watch_fd = -1;
+  p_inbuff->p_data = p_data;
+
+  return;
+}
+
+
+/**
+ * Initialization of the input buffer for file of given name. Regular file is
+ * mapped into memory, so the numbers are parsed straight from the mapped data
+ * and no copying through stdio buffer is performed. Other files (e.g. pipes)
+ * or files, which can't be mapped, are read by blocks as a stream instead.
+ * Returns EXIT_FAILURE and sets errno, if the file can't be opened or upon
+ * memory allocation error.
+ */
+int inbuff_open(TS_Inbuffer *p_inbuff, const char *p_fname)
+{
+  struct stat info;             /* Information about the file. */
+
+  void *p_map;                  /* Mapped memory. */
+
+  FILE *f_stream;               /* Stream used when mapping isn't possible. */
+
+  int fd = open(p_fname, O_RDONLY);
+
+  if (fd == -1)
+    return EXIT_FAILURE;
+
+  /*
+   * Only non-empty regular files can be mapped. (Empty size is reported also
+   * for some special files.)
+   */
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0
+      && (unsigned long long) info.st_size <= (size_t) -1) {
+
+    p_map = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (p_map != MAP_FAILED) {
+      close(fd);                /* Mapping stays valid. */
+
+      posix_madvise(p_map, (size_t) info.st_size, POSIX_MADV_SEQUENTIAL);
+
+      inbuff_mem(p_inbuff, (char *) p_map, (size_t) info.st_size);
+      p_inbuff->mapped = true;
+
+      return EXIT_SUCCESS;
+    }
+  }
+
+  /* Fallback to reading of stream. */
+  if ((f_stream = fdopen(fd, "r")) == NULL) {
+    close(fd);
+    return EXIT_FAILURE;
+  }
+
+  if (inbuff_init(p_inbuff, f_stream) == EXIT_FAILURE) {
+    fclose(f_stream);
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_inbuff->opened = true;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the input buffer for following of growing file of given
+ * name (--follow). The file is read as a stream from its' beginning, but the
+ * end of file doesn't end the reading - the reading functions wait for
+ * appended data by inotify instead. Returns EXIT_FAILURE and sets errno, if
+ * the file can't be opened or watched, upon memory allocation error or
+ * ENOSYS, if the following isn't supported.
+ */
+int inbuff_follow(TS_Inbuffer *p_inbuff, const char *p_fname)
+{
+#ifdef BUFIO_INOTIFY
+  FILE *f_stream = fopen(p_fname, "r");
+
+  int err;                      /* Backup of errno. */
+
+  if (f_stream == NULL)
+    return EXIT_FAILURE;
+
+  if (inbuff_init(p_inbuff, f_stream) == EXIT_FAILURE) {
+    fclose(f_stream);
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_inbuff->opened = true;
+
+  /* Every append to the file is reported by IN_MODIFY event. */
+  p_inbuff->watch_fd = inotify_init();
+
+  if (p_inbuff->watch_fd == -1
+      || inotify_add_watch(p_inbuff->watch_fd, p_fname, IN_MODIFY) == -1) {
+    err = errno;
+    inbuff_free(p_inbuff);
+    errno = err;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+#else
+  (void) p_inbuff;
+  (void) p_fname;
+
+  errno = ENOSYS;
+  return EXIT_FAILURE;
+#endif
+}
+
+
+/**
+ * Dispose of the input buffer. The stream is closed only if it was opened by
+ * inbuff_open() or inbuff_follow() function, the mapped file is unmapped.
+ */
+void inbuff_free(TS_Inbuffer *p_inbuff)
+{
+  if (p_inbuff->mapped == true)
+    munmap((void *) p_inbuff->p_data, p_inbuff->size);
+  else if (p_inbuff->f_stream != NULL)
+    free((void *) p_inbuff->p_data);
+
+  if (p_inbuff->opened == true)
+    fclose(p_inbuff->f_stream);
+
+  if (p_inbuff->watch_fd != -1)
+    close(p_inbuff->watch_fd);
+
+  p_inbuff->watch_fd = -1;
+
+  p_inbuff->f_stream = NULL;
+  p_inbuff->mapped = false;
+  p_inbuff->opened = false;
+
+  /* Values reseting for safety reasons. */
+  p_inbuff->size = 0;
+  p_inbuff->used = 0;
+  p_inbuff->pos = 0;
+  p_inbuff->p_data = NULL;
+
+  return;
+}
+
+
+/**
+ * Returns true, if there's whole line in the input buffer, which can be read
+ * without reading of its' stream. Used by --follow processing for ending of
+ * the batch before waiting for appended data.
+ */
+bool inbuff_has_line(TS_Inbuffer *p_inbuff)
+{
+  return memchr(p_inbuff->p_data + p_inbuff->pos, '\n',
+                p_inbuff->used - p_inbuff->pos) != NULL;
+}
+
+
+/**
+ * Initialization of the output buffer for given stream. Returns EXIT_FAILURE
+ * and sets errno to ENOMEM, if the memory allocation has failed. If NULL is
+ * given instead of stream, then the buffer is only kept in memory and it is
+ * extended when needed. Its' content has to be written by the caller then.
+ * Time values are stored by sprint_time_value(), the caller can set function
+ * specialized for its' max_unit into p_sprint afterwards.
+ */
+int outbuff_init(TS_Outbuffer *p_outbuff, FILE *f_stream)
+{
+  /* Buffer values initialization. */
+  p_outbuff->f_stream = f_stream;
+  p_outbuff->size = 0;
+  p_outbuff->used = 0;
+  p_outbuff->p_sprint = sprint_time_value;
+
+  /* Buffer memory allocation. */
+  p_outbuff->p_data = (char *) malloc(BUFF_SIZE_DEF * sizeof(char));
+
+  if (p_outbuff->p_data == NULL) {  /* Memory allocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->size = BUFF_SIZE_DEF;  /* New size of buffer. */
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Writes the content of the output buffer into its' stream. Returns
+ * EXIT_FAILURE upon writing error, errno is set by fwrite() then.
+ */
+int outbuff_flush(TS_Outbuffer *p_outbuff)
+{
+  size_t written = fwrite(p_outbuff->p_data, sizeof(char), p_outbuff->used,
+                          p_outbuff->f_stream);
+
+  if (written != p_outbuff->used) {
+    p_outbuff->used = 0;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->used = 0;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Dispose of the output buffer. The content of buffer is not flushed and the
+ * stream is not closed.
+ */
+void outbuff_free(TS_Outbuffer *p_outbuff)
+{
+  free((void *) p_outbuff->p_data);
+
+  /* Values reseting for safety reasons. */
+  p_outbuff->size = 0;
+  p_outbuff->used = 0;
+  p_outbuff->p_data = NULL;
+
+  return;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Refills the input buffer with another block from its' stream. Returns number
+ * of new characters in buffer, zero upon end of stream or reading error. When
+ * the file is followed, the end of file is not final - the function waits for
+ * appended data instead and it returns zero only upon error.
+ */
+static size_t inbuff_fill(TS_Inbuffer *p_inbuff)
+{
+  p_inbuff->pos = 0;
+  p_inbuff->used = 0;
+
+  if (p_inbuff->eof == true)
+    return 0;
+
+  if (p_inbuff->watch_fd != -1) {
+
+    while (true) {
+
+      /* The end of file indicator has to be cleared for another reading. */
+      clearerr(p_inbuff->f_stream);
+
+      p_inbuff->used = fread(p_inbuff->p_data, sizeof(char), p_inbuff->size,
+                             p_inbuff->f_stream);
+
+      if (p_inbuff->used > 0)
+        break;
+
+      if (ferror(p_inbuff->f_stream) || inbuff_wait(p_inbuff) == EXIT_FAILURE) {
+        p_inbuff->eof = true;   /* Error, no more reading. */
+        break;
+      }
+    }
+
+    return p_inbuff->used;
+  }
+
+  p_inbuff->used = fread(p_inbuff->p_data, sizeof(char), p_inbuff->size,
+                         p_inbuff->f_stream);
+
+  if (p_inbuff->used < p_inbuff->size)
+    p_inbuff->eof = true;   /* End of stream or error, no more reading. */
+
+  return p_inbuff->used;
+}
+
+
+/**
+ * Waits for modification of the followed file. Events are queued since the
+ * watch was added, so an append between the last reading and the waiting is
+ * not lost. Returns EXIT_FAILURE and sets errno upon error.
+ */
+static int inbuff_wait(TS_Inbuffer *p_inbuff)
+{
+#ifdef BUFIO_INOTIFY
+  /* Buffer for events, aligned as struct inotify_event requires. */
+  union {
+    struct inotify_event event;
+    char bytes[4096];
+  } events;
+
+  ssize_t got;
+
+  do {
+    got = read(p_inbuff->watch_fd, &events, sizeof(events));
+  } while (got == -1 && errno == EINTR);
+
+  return (got > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+  (void) p_inbuff;
+
+  errno = ENOSYS;
+  return EXIT_FAILURE;
+#endif
+}
+
+
+/**
+ * Reads another block from the stream of the input buffer, but unlike
+ * inbuff_fill() it keeps the unprocessed characters - they are moved to the
+ * beginning of the buffer first. If the whole buffer is unprocessed, it is
+ * extended to double of its' size. Returns number of new characters in buffer,
+ * zero upon end of stream or error. The errno is set to ENOMEM, if the memory
+ * reallocation has failed.
+ */
+static size_t inbuff_more(TS_Inbuffer *p_inbuff)
+{
+  size_t rest = p_inbuff->used - p_inbuff->pos;   /* Unprocessed characters. */
+  size_t got;                                     /* Read characters. */
+
+  if (p_inbuff->eof == true)
+    return 0;
+
+  if (p_inbuff->pos > 0) {
+    memmove(p_inbuff->p_data, p_inbuff->p_data + p_inbuff->pos, rest);
+    p_inbuff->pos = 0;
+    p_inbuff->used = rest;
+  }
+  else if (p_inbuff->used == p_inbuff->size) {
+
+    char *p_new = (char *) realloc((void *) p_inbuff->p_data,
+                                   2 * p_inbuff->size * sizeof(char));
+
+    if (p_new == NULL) {          /* Memory reallocation failed? */
+      p_inbuff->eof = true;
+      errno = ENOMEM;
+      return 0;
+    }
+
+    p_inbuff->p_data = p_new;
+    p_inbuff->size *= 2;          /* New size of buffer. */
+  }
+
+  got = fread(p_inbuff->p_data + p_inbuff->used, sizeof(char),
+              p_inbuff->size - p_inbuff->used, p_inbuff->f_stream);
+
+  if (got < p_inbuff->size - p_inbuff->used)
+    p_inbuff->eof = true;   /* End of stream or error, no more reading. */
+
+  p_inbuff->used += got;
+
+  return got;
+}
+
+
+/**
+ * Finds next line in the input buffer, reading more of its' stream when
+ * needed. The pointer to the line (valid until next reading) and its' length
+ * without '\n' are stored by given pointers. Last line doesn't have to be
+ * terminated by '\n'. Returns EOF for empty line or end of input, like
+ * readtoul(), EXIT_SUCCESS for read line and EXIT_FAILURE upon error.
+ */
+static int inbuff_line(TS_Inbuffer *p_inbuff, const char **pp_line,
+                       size_t *p_length)
+{
+  size_t searched = 0;      /* Characters already searched for '\n'. */
+
+  char *p_nl;               /* Position of '\n'. */
+
+  errno = ESUCCESS;
+
+  while (true) {
+
+    p_nl = (char *) memchr(p_inbuff->p_data + p_inbuff->pos + searched, '\n',
+                           p_inbuff->used - p_inbuff->pos - searched);
+
+    if (p_nl != NULL) {     /* Complete line. */
+      *pp_line = p_inbuff->p_data + p_inbuff->pos;
+      *p_length = (size_t) (p_nl - *pp_line);
+      p_inbuff->pos = (size_t) (p_nl - p_inbuff->p_data) + 1;
+      break;
+    }
+
+    searched = p_inbuff->used - p_inbuff->pos;
+
+    if (inbuff_more(p_inbuff) == 0) {   /* Last line without '\n'. */
+      *pp_line = p_inbuff->p_data + p_inbuff->pos;
+      *p_length = p_inbuff->used - p_inbuff->pos;
+      p_inbuff->pos = p_inbuff->used;
+      break;
+    }
+  }
+
+  /* Error upon reading of the stream or memory reallocation? */
+  if (errno == ENOMEM || (p_inbuff->f_stream != NULL
+                          && ferror(p_inbuff->f_stream) && errno != ESUCCESS))
+    return EXIT_FAILURE;
+  else if (*p_length == 0)
+    return EOF;             /* Empty line or no input. */
+  else
+    return EXIT_SUCCESS;
+}
+
+
+/**
+ * Extends the output buffer without stream to double of its' size. Returns
+ * EXIT_FAILURE and sets errno to ENOMEM, if the memory reallocation has failed.
+ * The content of buffer is kept in that case.
+ */
+static int outbuff_ext(TS_Outbuffer *p_outbuff)
+{
+  char *p_new = (char *) realloc((void *) p_outbuff->p_data,
+                                 2 * p_outbuff->size * sizeof(char));
+
+  if (p_new == NULL) {              /* Memory reallocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->p_data = p_new;
+  p_outbuff->size *= 2;             /* New size of buffer. */
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Makes sure there's space for at least n characters in the output buffer by
+ * flushing it (or extending it, if it has no stream or it's too small).
+ * Returns EXIT_FAILURE and sets errno upon error.
+ */
+static int outbuff_reserve(TS_Outbuffer *p_outbuff, size_t n)
+{
+  if (p_outbuff->size - p_outbuff->used >= n)
+    return EXIT_SUCCESS;
+
+  if (p_outbuff->f_stream != NULL
+      && outbuff_flush(p_outbuff) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  while (p_outbuff->size - p_outbuff->used < n) {
+    if (outbuff_ext(p_outbuff) == EXIT_FAILURE)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Stores given value as little-endian 64 bit unsigned integer at given address
+ * and returns the address following the last stored byte.
+ */
+static inline unsigned char *u64tole(unsigned long long value,
+                                     unsigned char *p_dest)
+{
+  for (int i = 0; i < BIN_VALUE_SIZE; i++) {
+    p_dest[i] = (unsigned char) (value & 0xFF);
+    value >>= CHAR_BIT;
+  }
+
+  return p_dest + BIN_VALUE_SIZE;
+}
+
+
+/******************************************************************************
+ ***[END OF PROJ1BUFIO.C]******************************************************
+ ******************************************************************************/
@@ -0,0 +1,133 @@
+/**
+ * File:          proj1bufio.h
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This header file contains functional prototypes of functions
+ *                of proj1bufio.c module and structures of input and output
+ *                buffers used alongside them.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1BUFIO.H]***************************************************
+ ******************************************************************************/
+
+/*
+ * Safety mechanism against multi-including of of this .h file.
+ */
+#ifndef PROJ1BUFIO_H
+
+#define PROJ1BUFIO_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "proj1timeconv.h"
+
+
+/******************************************************************************
+ ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Size of one binary input value (little-endian 64 bit unsigned integer). */
+#define BIN_VALUE_SIZE 8
+
+/*
+ * Size of one binary output record, which contains weeks, days, hours, minutes
+ * and seconds, every value as little-endian 64 bit unsigned integer.
+ */
+#define BIN_RECORD_SIZE (5 * BIN_VALUE_SIZE)
+
+
+/******************************************************************************
+ ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Structure containing informations about buffer for reading input stream in
+ * large blocks.
+ */
+typedef struct inbuffer {
+  FILE *f_stream;           /* Stream to read from. */
+
+  size_t size;              /* Size of the buffer. */
+  size_t used;              /* Number of valid characters in the buffer. */
+  size_t pos;               /* Position of next character to process. */
+
+  bool eof;                 /* Was the end of stream reached? */
+  bool mapped;              /* Is the buffer memory-mapped file? */
+  bool opened;              /* Was the stream opened by inbuff_open()? */
+
+  int watch_fd;             /* Inotify descriptor for following, or -1. */
+
+  char *p_data;             /* Pointer to memory of buffer. */
+} TS_Inbuffer;
+
+
+/*
+ * Structure containing informations about buffer for writing output stream in
+ * large blocks.
+ */
+typedef struct outbuffer {
+  FILE *f_stream;           /* Stream to write into. */
+
+  size_t size;              /* Size of the buffer. */
+  size_t used;              /* Number of used characters from buffer. */
+
+  char *p_data;             /* Pointer to memory of buffer. */
+
+  TF_Sprinter p_sprint;     /* Function storing time values as text. */
+} TS_Outbuffer;
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF GLOBAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+int inbuff_init(TS_Inbuffer *p_inbuff, FILE *f_stream);
+int inbuff_open(TS_Inbuffer *p_inbuff, const char *p_fname);
+void inbuff_mem(TS_Inbuffer *p_inbuff, char *p_data, size_t size);
+int inbuff_follow(TS_Inbuffer *p_inbuff, const char *p_fname);
+void inbuff_free(TS_Inbuffer *p_inbuff);
+
+bool inbuff_has_line(TS_Inbuffer *p_inbuff);
+
+int outbuff_init(TS_Outbuffer *p_outbuff, FILE *f_stream);
+int outbuff_flush(TS_Outbuffer *p_outbuff);
+void outbuff_free(TS_Outbuffer *p_outbuff);
+
+int breadtoul(TS_Inbuffer *p_inbuff, unsigned long *p_num);
+
+int bprint_time_value(TS_Outbuffer *p_outbuff, TS_Time *p_time);
+
+int breadu64(TS_Inbuffer *p_inbuff, unsigned long *p_num);
+int bwrite_time_value(TS_Outbuffer *p_outbuff, TS_Time *p_time);
+
+int breadtime(TS_Inbuffer *p_inbuff, unsigned long *p_num);
+int bprint_ul(TS_Outbuffer *p_outbuff, unsigned long *p_num);
+
+int breaddigits(TS_Inbuffer *p_inbuff, const char **pp_digits,
+                size_t *p_length);
+int bprint_time_decimal(TS_Outbuffer *p_outbuff, const char *p_digits,
+                        size_t length, TE_Max_unit max_unit);
+
+#endif
+
+/******************************************************************************
+ ***[END OF PROJ1BUFIO.H]******************************************************
+ ******************************************************************************/
@@ -0,0 +1,443 @@
+/**
+ * File:          proj1parallel.c
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This module contains functions for processing of possible
+ *                endless sequence of input values by multiple threads. Input
+ *                is split into chunks at the ends of lines, every chunk is
+ *                converted by its' own thread into its' own output buffer and
+ *                the output buffers are then written in the input order.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1PARALLEL.C ]***********************************************
+ ******************************************************************************/
+
+/* Needed for sysconf() with -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "proj1timeconv.h"
+#include "proj1bufio.h"
+#include "proj1parallel.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Minimal size of input data of one chunk. */
+static const size_t CHUNK_SIZE = 1048576;
+
+/* Number of values converted at once by one thread. */
+#define CHUNK_BATCH 1024
+
+
+/******************************************************************************
+ ~~~[ LOCAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Structure containing one chunk of input lines and the results of its'
+ * conversion.
+ */
+typedef struct chunk {
+  TF_Converter p_convert;   /* Converter specialized for maximum time unit. */
+
+  char *p_lines;            /* Lines to convert. */
+
+  char *p_data;             /* Memory for input data read from stream. */
+  size_t size;              /* Size of memory of input data. */
+  size_t filled;            /* Number of read characters. */
+  size_t used;              /* Number of characters of whole lines. */
+
+  TS_Outbuffer outbuff;     /* Converted values. */
+
+  unsigned long lines;      /* Number of converted lines. */
+
+  /*
+   * EXIT_SUCCESS if whole chunk was converted, EOF if conversion was stopped
+   * by empty line (end of input, same as readtoul()) or EXIT_FAILURE upon
+   * error, which is stored in err then.
+   */
+  int ret_val;
+  int err;
+} TS_Chunk;
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+static int chunk_read(TS_Chunk *p_chunk, TS_Chunk *p_prev,
+                      TS_Inbuffer *p_inbuff, bool *p_eof);
+
+static void *chunk_convert(void *p_arg);
+
+
+/******************************************************************************
+ ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Same as process_sequence() function in proj1.c module, but the input values
+ * from given input buffer are converted by given number of threads (0 stands
+ * for number of online processors) and written to f_out. Chunks of buffer in
+ * memory (mapped file) are converted in place, stream is read into chunks.
+ * Results are written in the input order and the processing ends at the same
+ * line as it would end when it's processed sequentially. Returns EXIT_SUCCESS
+ * or EXIT_FAILURE and sets errno upon error. The number of line with invalid
+ * value (EDOM or EOVERFLOW) is stored by p_line pointer then, for any other
+ * error (reading, writing, memory allocation) it's set to 0.
+ */
+int process_sequence_mt(TS_Inbuffer *p_inbuff, FILE *f_out,
+                        TE_Max_unit max_unit, int threads,
+                        unsigned long *p_line)
+{
+  TS_Chunk chunks[MAX_THREADS];   /* Chunks of one round of conversion. */
+  pthread_t tids[MAX_THREADS];    /* Identifiers of worker threads. */
+  bool started[MAX_THREADS];      /* Was the thread started? */
+
+  TS_Chunk *p_prev = NULL;        /* Last read chunk. */
+
+  /* Functions specialized for max_unit are selected only once. */
+  TF_Converter p_convert = select_converter(max_unit);
+  TF_Sprinter p_sprint = select_sprinter(max_unit);
+
+  bool eof = false;               /* Was the whole input read? */
+  bool done = false;              /* Was the processing stopped? */
+
+  int ret_val = EXIT_SUCCESS;     /* Return value. */
+  int err = 0;                    /* Backup of errno. */
+
+  unsigned long line = 0;         /* Number of already written lines. */
+
+  int active;                     /* Number of chunks in actual round. */
+  int t;                          /* Iteration counter. */
+
+
+  /* Number of threads correction. */
+  if (threads <= 0) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (online > 0) ? (int) online : 1;
+  }
+
+  if (threads > MAX_THREADS)
+    threads = MAX_THREADS;
+
+  *p_line = 0;
+
+  if (p_convert == NULL || p_sprint == NULL)
+    return EXIT_FAILURE;    /* Wrong max_unit, errno is set. */
+
+  /* Initialization of chunks. */
+  for (t = 0; t < threads; t++) {
+    chunks[t].p_convert = p_convert;
+    chunks[t].p_lines = NULL;
+    chunks[t].p_data = NULL;
+    chunks[t].size = 0;
+    chunks[t].filled = 0;
+    chunks[t].used = 0;
+
+    if (outbuff_init(&chunks[t].outbuff, NULL) == EXIT_FAILURE) {
+      err = errno;
+      ret_val = EXIT_FAILURE;
+      threads = t;                /* Only initialized chunks are freed. */
+      done = true;
+      break;
+    }
+
+    chunks[t].outbuff.p_sprint = p_sprint;
+  }
+
+
+  /*
+   * Every round reads one chunk for every thread, converts them in parallel
+   * and writes the results in the input order.
+   */
+  while (done == false && eof == false) {
+
+    /* Reading of chunks. */
+    for (active = 0; active < threads && eof == false; active++) {
+
+      if (chunk_read(&chunks[active], p_prev, p_inbuff, &eof)
+          == EXIT_FAILURE) {
+        err = errno;
+        ret_val = EXIT_FAILURE;
+        done = true;
+        break;                    /* Already read chunks are processed. */
+      }
+
+      p_prev = &chunks[active];
+
+      if (chunks[active].used == 0)
+        break;                    /* Nothing more to convert. */
+    }
+
+    /* Conversion. The chunk is converted here, if the thread can't start. */
+    for (t = 0; t < active; t++) {
+      started[t] = (pthread_create(&tids[t], NULL, chunk_convert,
+                                   (void *) &chunks[t]) == 0);
+
+      if (started[t] == false)
+        chunk_convert((void *) &chunks[t]);
+    }
+
+    for (t = 0; t < active; t++)
+      if (started[t] == true)
+        pthread_join(tids[t], NULL);
+
+    /* Writing of results in the input order. */
+    for (t = 0; t < active; t++) {
+
+      if (fwrite(chunks[t].outbuff.p_data, sizeof(char),
+                 chunks[t].outbuff.used, f_out) != chunks[t].outbuff.used) {
+        err = errno;
+        ret_val = EXIT_FAILURE;
+        done = true;
+        break;
+      }
+
+      if (chunks[t].ret_val == EXIT_SUCCESS) {
+        line += chunks[t].lines;
+        continue;
+      }
+
+      done = true;                /* No more chunks are written. */
+
+      if (chunks[t].ret_val == EXIT_FAILURE) {
+        err = chunks[t].err;
+        ret_val = EXIT_FAILURE;
+
+        /* Only invalid values are related to the line of input. */
+        if (err == EDOM || err == EOVERFLOW)
+          *p_line = line + chunks[t].lines + 1;
+      }
+      else {
+        ret_val = EXIT_SUCCESS;   /* Empty line, read errors are ignored. */
+      }
+
+      break;
+    }
+  }
+
+  /* Dispose of chunks. */
+  for (t = 0; t < threads; t++) {
+    free((void *) chunks[t].p_data);
+    outbuff_free(&chunks[t].outbuff);
+  }
+
+  errno = err;
+
+  return ret_val;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Reads new chunk of whole lines from given input buffer. If the buffer is in
+ * memory, then the chunk is only the next part of it ending by end of line.
+ * Otherwise the chunk is read from stream of the buffer. The part of last line
+ * of previous chunk (if any) is moved to the beginning of the new chunk then.
+ * Memory of chunk is extended, if there's no end of line in it. Sets the value
+ * of p_eof to true upon end of input. Returns EXIT_FAILURE and sets errno upon
+ * error.
+ */
+static int chunk_read(TS_Chunk *p_chunk, TS_Chunk *p_prev,
+                      TS_Inbuffer *p_inbuff, bool *p_eof)
+{
+  FILE *f_in = p_inbuff->f_stream;  /* Stream to read from. */
+
+  size_t carry = 0;               /* Size of part of previous line. */
+  size_t new_size;                /* New size of memory. */
+  size_t read;                    /* Number of read characters. */
+  size_t scanned;                 /* Characters with no end of line. */
+  char *p_new;                    /* Helpful pointer for reallocation. */
+
+
+  /* Input in memory, no copying is needed. */
+  if (f_in == NULL) {
+    size_t rest = p_inbuff->used - p_inbuff->pos;
+    size_t length = rest;
+
+    p_chunk->p_lines = p_inbuff->p_data + p_inbuff->pos;
+
+    /* Chunk ends by the first end of line after CHUNK_SIZE characters. */
+    if (rest > CHUNK_SIZE) {
+      char *p_eol = memchr(p_chunk->p_lines + CHUNK_SIZE - 1, '\n',
+                           rest - CHUNK_SIZE + 1);
+
+      if (p_eol != NULL)
+        length = (size_t) (p_eol - p_chunk->p_lines) + 1;
+    }
+
+    p_inbuff->pos += length;
+    p_chunk->filled = length;
+    p_chunk->used = length;
+
+    if (p_inbuff->pos == p_inbuff->used)
+      *p_eof = true;
+
+    return EXIT_SUCCESS;
+  }
+
+
+  if (p_prev != NULL)
+    carry = p_prev->filled - p_prev->used;
+
+  /* There has to be space for carry and at least CHUNK_SIZE characters. */
+  if (p_chunk->size < carry + CHUNK_SIZE) {
+    new_size = carry + CHUNK_SIZE;
+    p_new = (char *) realloc((void *) p_chunk->p_data, new_size);
+
+    if (p_new == NULL) {
+      errno = ENOMEM;
+      return EXIT_FAILURE;
+    }
+
+    p_chunk->p_data = p_new;
+    p_chunk->size = new_size;
+  }
+
+  /* Previous chunk can be the same chunk (one thread only). */
+  if (carry > 0)
+    memmove(p_chunk->p_data, p_prev->p_data + p_prev->used, carry);
+
+  p_chunk->p_lines = p_chunk->p_data;
+  p_chunk->filled = carry;
+  p_chunk->used = 0;
+  scanned = carry;
+
+  /* Reading until there's an end of line in the chunk. */
+  while (true) {
+    read = fread(p_chunk->p_data + p_chunk->filled, sizeof(char),
+                 p_chunk->size - p_chunk->filled, f_in);
+
+    p_chunk->filled += read;
+
+    /* End of input or error? Whole rest belongs to this chunk. */
+    if (p_chunk->filled < p_chunk->size) {
+      *p_eof = true;
+      p_chunk->used = p_chunk->filled;
+      return (ferror(f_in)) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /* Searching for the last end of line. */
+    for (size_t i = p_chunk->filled; i > scanned; i--) {
+      if (p_chunk->p_data[i - 1] == '\n') {
+        p_chunk->used = i;
+        return EXIT_SUCCESS;
+      }
+    }
+
+    scanned = p_chunk->filled;
+
+    /* Too long line, extending the memory. */
+    new_size = 2 * p_chunk->size;
+    p_new = (char *) realloc((void *) p_chunk->p_data, new_size);
+
+    if (p_new == NULL) {
+      errno = ENOMEM;
+      return EXIT_FAILURE;
+    }
+
+    p_chunk->p_data = p_new;
+    p_chunk->size = new_size;
+  }
+}
+
+
+/**
+ * Thread function converting one chunk, which is given by p_arg pointer, into
+ * its' output buffer. It works the same way as process_sequence() function,
+ * the result is stored in given chunk.
+ */
+static void *chunk_convert(void *p_arg)
+{
+  TS_Chunk *p_chunk = (TS_Chunk *) p_arg;
+
+  TS_Time times[CHUNK_BATCH];           /* Processed values of time. */
+  unsigned long seconds[CHUNK_BATCH];   /* Values of input numbers. */
+
+  TS_Inbuffer inbuff;       /* Input buffer over data of chunk. */
+
+  size_t count;             /* Number of values in actual batch. */
+  size_t pos = 0;           /* Position of last read line. */
+
+  int ret_val;              /* Return value of called function. */
+
+
+  inbuff_mem(&inbuff, p_chunk->p_lines, p_chunk->used);
+
+  p_chunk->outbuff.used = 0;
+  p_chunk->lines = 0;
+  p_chunk->err = 0;
+
+  do {
+    count = 0;
+
+    do {
+      pos = inbuff.pos;
+      ret_val = breadtoul(&inbuff, &seconds[count]);
+    } while (ret_val == EXIT_SUCCESS && ++count < CHUNK_BATCH);
+
+    p_chunk->err = errno;
+
+    p_chunk->p_convert(seconds, times, count);
+
+    for (size_t i = 0; i < count; i++) {
+      if (bprint_time_value(&p_chunk->outbuff, &times[i]) == EXIT_FAILURE) {
+        p_chunk->err = errno;
+        p_chunk->lines += i;
+        p_chunk->ret_val = EXIT_FAILURE;
+        return NULL;
+      }
+    }
+
+    p_chunk->lines += count;
+
+  } while (ret_val == EXIT_SUCCESS);
+
+  /* Empty line inside of the chunk stops the conversion. */
+  if (ret_val == EOF)
+    p_chunk->ret_val = (pos < inbuff.used) ? EOF : EXIT_SUCCESS;
+  else
+    p_chunk->ret_val = EXIT_FAILURE;
+
+  return NULL;
+}
+
+
+/******************************************************************************
+ ***[END OF PROJ1PARALLEL.C]***************************************************
+ ******************************************************************************/
@@ -0,0 +1,62 @@
+/**
+ * File:          proj1parallel.h
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This header file contains functional prototypes of functions
+ *                of proj1parallel.c module, which processes the sequence of
+ *                input values by multiple threads.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1PARALLEL.H]************************************************
+ ******************************************************************************/
+
+/*
+ * Safety mechanism against multi-including of of this .h file.
+ */
+#ifndef PROJ1PARALLEL_H
+
+#define PROJ1PARALLEL_H
+
+#include <stdio.h>
+
+#include "proj1timeconv.h"
+#include "proj1bufio.h"
+
+
+/******************************************************************************
+ ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#define MAX_THREADS 64              /* Maximal number of worker threads. */
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF GLOBAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+int process_sequence_mt(TS_Inbuffer *p_inbuff, FILE *f_out,
+                        TE_Max_unit max_unit, int threads,
+                        unsigned long *p_line);
+
+#endif
+
+/******************************************************************************
+ ***[END OF PROJ1PARALLEL.H]***************************************************
+ ******************************************************************************/
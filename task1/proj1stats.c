@@ -0,0 +1,524 @@
+/**
+ * File:          proj1stats.c
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This module contains functions for computing of statistics
+ *                of possible endless sequence of input values (--stats) in one
+ *                pass: total, minimum, maximum, mean, percentiles and the
+ *                histogram of values by their highest time unit. Values are
+ *                printed by print_time_value() function.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1STATS.C ]**************************************************
+ ******************************************************************************/
+
+/******************************************************************************
+ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "proj1timeconv.h"
+#include "proj1stats.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Initial number of stored values for exact percentiles. */
+static const size_t VALUES_SIZE_DEF = 65536;
+
+/* Number of bits of unsigned long. */
+#define ULONG_BITS ((int) (sizeof(unsigned long) * CHAR_BIT))
+
+/*
+ * Every power of two range of values is divided into SKETCH_SUB buckets of the
+ * sketch, so the relative error of approximated percentile is lower than
+ * 1 / SKETCH_SUB. Values lower than SKETCH_SUB have their own bucket.
+ */
+#define SKETCH_BITS 7
+#define SKETCH_SUB (1LU << SKETCH_BITS)
+#define SKETCH_BUCKETS ((size_t) (ULONG_BITS - SKETCH_BITS + 1) * SKETCH_SUB)
+
+/* Number of computed percentiles. */
+#define PERCENTILES_COUNT 3
+
+/* Computed percentiles. */
+static const unsigned long percentiles[PERCENTILES_COUNT] = { 50, 90, 99 };
+
+/* Number of seconds of every unit, used for histogram of units. */
+static const unsigned long units_secs[] = {
+  [SECONDS] = 1,
+  [MINUTES] = 60,
+  [HOURS]   = 3600,
+  [DAYS]    = 86400,
+  [WEEKS]   = 604800,
+};
+
+/* Names of histogram lines of every unit. */
+static const char *units_labels[] = {
+  [SECONDS] = "sekundy",
+  [MINUTES] = "minuty",
+  [HOURS]   = "hodiny",
+  [DAYS]    = "dny",
+  [WEEKS]   = "tydny",
+};
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+static int values_reserve(TS_Stats *p_stats, size_t n);
+
+static inline size_t sketch_index(unsigned long value);
+
+static unsigned long sketch_value(size_t index);
+
+static unsigned long sketch_select(TS_Stats *p_stats, unsigned long rank);
+
+static unsigned long select_nth(unsigned long *p_values, size_t n, size_t k);
+
+static unsigned long percentile_rank(unsigned long count,
+                                     unsigned long percentile);
+
+static void print_stat(const char *p_label, unsigned long value,
+                       TE_Max_unit max_unit);
+
+static void print_total(TU_Total total, TE_Max_unit max_unit);
+
+
+/******************************************************************************
+ ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Initialization of statistics for values converted with given max_unit. If
+ * sketch is true, then the percentiles are approximated in constant memory,
+ * otherwise every value is stored. Returns EXIT_FAILURE and sets errno to
+ * ENOMEM, if the memory allocation has failed.
+ */
+int stats_init(TS_Stats *p_stats, TE_Max_unit max_unit, bool sketch)
+{
+  p_stats->max_unit = max_unit;
+  p_stats->count = 0;
+  p_stats->total = 0;
+  p_stats->min = ULONG_MAX;
+  p_stats->max = 0;
+
+  for (int unit = 0; unit <= WEEKS; unit++)
+    p_stats->units[unit] = 0;
+
+  p_stats->sketch = sketch;
+  p_stats->p_values = NULL;
+  p_stats->size = 0;
+  p_stats->p_buckets = NULL;
+
+  if (sketch == true) {
+    p_stats->p_buckets = (unsigned long *) calloc(SKETCH_BUCKETS,
+                                                  sizeof(unsigned long));
+
+    if (p_stats->p_buckets == NULL) {
+      errno = ENOMEM;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Dispose of the statistics.
+ */
+void stats_free(TS_Stats *p_stats)
+{
+  free((void *) p_stats->p_values);
+  free((void *) p_stats->p_buckets);
+
+  /* Values reseting for safety reasons. */
+  p_stats->p_values = NULL;
+  p_stats->p_buckets = NULL;
+  p_stats->size = 0;
+  p_stats->count = 0;
+
+  return;
+}
+
+
+/**
+ * Adds n values from the field p_in into the statistics. Returns EXIT_SUCCESS
+ * or EXIT_FAILURE and sets errno to ENOMEM upon memory allocation error. The
+ * errno is set to EOVERFLOW, if the total cannot be stored in TU_Total. (That
+ * is possible only, if there's no wider type than unsigned long.) The values
+ * preceding the wrong one are added in that case.
+ */
+int stats_add(TS_Stats *p_stats, const unsigned long *p_in, size_t n)
+{
+  unsigned long value;          /* Actual value. */
+
+  int unit;                     /* Highest unit of actual value. */
+
+
+  if (p_stats->sketch == false && values_reserve(p_stats, n) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  for (size_t i = 0; i < n; i++) {
+
+    value = p_in[i];
+
+#ifndef STATS_TOTAL_WIDE
+    if (value > ULONG_MAX - p_stats->total) {
+      errno = EOVERFLOW;        /* Total too big to be stored. */
+      return EXIT_FAILURE;
+    }
+#endif
+
+    p_stats->total += value;
+
+    if (value < p_stats->min)
+      p_stats->min = value;
+
+    if (value > p_stats->max)
+      p_stats->max = value;
+
+    /* Highest unit of the value, which can be displayed. */
+    for (unit = p_stats->max_unit; unit > SECONDS; unit--) {
+      if (value >= units_secs[unit])
+        break;
+    }
+
+    p_stats->units[unit]++;
+
+    if (p_stats->sketch == true)
+      p_stats->p_buckets[sketch_index(value)]++;
+    else
+      p_stats->p_values[p_stats->count] = value;
+
+    p_stats->count++;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Prints the statistics to stdout, every value on its' own line preceded by
+ * its' label. Values of time are printed by print_time_value() function. The
+ * percentiles are computed by nearest rank method, stored values are reordered
+ * by that.
+ */
+void stats_print(TS_Stats *p_stats)
+{
+  unsigned long count = p_stats->count;   /* Number of values. */
+  unsigned long mean;                     /* Rounded mean value. */
+  unsigned long rank;                     /* Rank of percentile. */
+  unsigned long value;                    /* Value of percentile. */
+
+  size_t from = 0;          /* Values before this index are selected. */
+
+  char s_label[32];         /* Label of percentile. */
+
+
+  fprintf(stdout, "pocet: %lu\n", count);
+
+  if (count == 0)           /* Nothing more to print. */
+    return;
+
+  /*
+   * Mean rounded half up, without overflow of total. It's never bigger than
+   * maximum, so it fits into unsigned long.
+   */
+  mean = (unsigned long) (p_stats->total / count);
+
+  if (p_stats->total % count >= count - p_stats->total % count)
+    mean++;
+
+  print_total(p_stats->total, p_stats->max_unit);
+  print_stat("minimum", p_stats->min, p_stats->max_unit);
+  print_stat("maximum", p_stats->max, p_stats->max_unit);
+  print_stat("prumer", mean, p_stats->max_unit);
+
+  /*
+   * Percentiles are sorted, so every selection of stored values continues
+   * after the previous one.
+   */
+  for (int i = 0; i < PERCENTILES_COUNT; i++) {
+
+    rank = percentile_rank(count, percentiles[i]);
+
+    if (p_stats->sketch == true)
+      value = sketch_select(p_stats, rank);
+    else if (rank - 1 < from)
+      value = p_stats->p_values[rank - 1];
+    else {
+      value = select_nth(p_stats->p_values + from, count - from,
+                         rank - 1 - from);
+      from = rank;
+    }
+
+    snprintf(s_label, sizeof(s_label), "percentil %lu", percentiles[i]);
+    print_stat(s_label, value, p_stats->max_unit);
+  }
+
+  /* Histogram of values by their highest unit. */
+  for (int unit = SECONDS; unit <= (int) p_stats->max_unit; unit++)
+    fprintf(stdout, "%s: %lu\n", units_labels[unit], p_stats->units[unit]);
+
+  return;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Makes sure there's space for another n values in the field of stored values,
+ * which is extended to double of its' size when needed. Returns EXIT_FAILURE
+ * and sets errno to ENOMEM, if the memory reallocation has failed.
+ */
+static int values_reserve(TS_Stats *p_stats, size_t n)
+{
+  size_t size = (p_stats->size == 0) ? VALUES_SIZE_DEF : p_stats->size;
+
+  unsigned long *p_new;             /* Reallocated field. */
+
+  if (p_stats->size - p_stats->count >= n && p_stats->p_values != NULL)
+    return EXIT_SUCCESS;
+
+  while (size - p_stats->count < n)
+    size *= 2;
+
+  p_new = (unsigned long *) realloc((void *) p_stats->p_values,
+                                    size * sizeof(unsigned long));
+
+  if (p_new == NULL) {              /* Memory reallocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_stats->p_values = p_new;
+  p_stats->size = size;             /* New size of the field. */
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Returns index of the bucket of the sketch for given value. Value with the
+ * highest bit at position e (e >= SKETCH_BITS) belongs to the group of
+ * buckets e - SKETCH_BITS + 1, the bucket in the group is given by next
+ * SKETCH_BITS bits of the value.
+ */
+static inline size_t sketch_index(unsigned long value)
+{
+  int e;                        /* Position of the highest bit. */
+
+  if (value < SKETCH_SUB)
+    return (size_t) value;
+
+#ifdef __GNUC__
+  e = ULONG_BITS - 1 - __builtin_clzl(value);
+#else
+  for (e = ULONG_BITS - 1; (value >> e) == 0; e--)
+    ;
+#endif
+
+  return (size_t) (e - SKETCH_BITS + 1) * SKETCH_SUB
+         + (size_t) ((value >> (e - SKETCH_BITS)) & (SKETCH_SUB - 1));
+}
+
+
+/**
+ * Returns the value representing the bucket of the sketch of given index -
+ * the middle of values belonging to the bucket.
+ */
+static unsigned long sketch_value(size_t index)
+{
+  size_t group = index / SKETCH_SUB;      /* Group of buckets. */
+
+  if (group == 0)
+    return (unsigned long) index;         /* Exact value. */
+
+  unsigned long width = 1LU << (group - 1);
+  unsigned long low = (SKETCH_SUB + index % SKETCH_SUB) << (group - 1);
+
+  return low + (width - 1) / 2;
+}
+
+
+/**
+ * Returns the approximated value of given rank (starting from 1) from the
+ * buckets of the sketch. The result is kept between minimum and maximum.
+ */
+static unsigned long sketch_select(TS_Stats *p_stats, unsigned long rank)
+{
+  unsigned long seen = 0;       /* Number of values in previous buckets. */
+
+  unsigned long value = p_stats->max;
+
+  for (size_t i = 0; i < SKETCH_BUCKETS; i++) {
+
+    seen += p_stats->p_buckets[i];
+
+    if (seen >= rank) {
+      value = sketch_value(i);
+      break;
+    }
+  }
+
+  if (value < p_stats->min)
+    value = p_stats->min;
+  else if (value > p_stats->max)
+    value = p_stats->max;
+
+  return value;
+}
+
+
+/**
+ * Returns the k-th smallest value (starting from 0) of the field of n values.
+ * The field is reordered, so the values before k-th are lower or equal and
+ * the values after it are greater or equal to it. (Wirth's selection
+ * algorithm, linear time in average case.)
+ */
+static unsigned long select_nth(unsigned long *p_values, size_t n, size_t k)
+{
+  ptrdiff_t left = 0;                     /* Bounds of selected part. */
+  ptrdiff_t right = (ptrdiff_t) n - 1;
+
+  ptrdiff_t i;                            /* Iteration counters. */
+  ptrdiff_t j;
+
+  unsigned long pivot;                    /* Actual pivot. */
+  unsigned long tmp;                      /* Helpful value for swapping. */
+
+
+  while (left < right) {
+
+    pivot = p_values[k];
+    i = left;
+    j = right;
+
+    do {
+      while (p_values[i] < pivot)
+        i++;
+
+      while (pivot < p_values[j])
+        j--;
+
+      if (i <= j) {
+        tmp = p_values[i];
+        p_values[i] = p_values[j];
+        p_values[j] = tmp;
+        i++;
+        j--;
+      }
+    } while (i <= j);
+
+    if (j < (ptrdiff_t) k)
+      left = i;
+
+    if ((ptrdiff_t) k < i)
+      right = j;
+  }
+
+  return p_values[k];
+}
+
+
+/**
+ * Returns the rank (starting from 1) of given percentile of count values by
+ * nearest rank method, ceil(percentile / 100 * count), without overflow.
+ */
+static unsigned long percentile_rank(unsigned long count,
+                                     unsigned long percentile)
+{
+  unsigned long rank = count / 100 * percentile
+                       + (count % 100 * percentile + 99) / 100;
+
+  return (rank == 0) ? 1 : rank;
+}
+
+
+/**
+ * Prints one line of statistics to stdout: given label and given value
+ * converted with given max_unit.
+ */
+static void print_stat(const char *p_label, unsigned long value,
+                       TE_Max_unit max_unit)
+{
+  TS_Time time = process_time_value(value, max_unit);
+
+  fprintf(stdout, "%s: ", p_label);
+  print_time_value(&time);
+
+  return;
+}
+
+
+/**
+ * Prints the line of statistics with the total. Total bigger than ULONG_MAX is
+ * converted to decimal string and printed by sprint_time_decimal().
+ */
+static void print_total(TU_Total total, TE_Max_unit max_unit)
+{
+  /* Digits of the total, generated from the lowest one. */
+  char digits[sizeof(TU_Total) * CHAR_BIT];
+
+  char s_time[sizeof(digits) + MAX_TIME_STR];   /* Converted total. */
+
+  char *p_digit = digits + sizeof(digits);      /* Position of last digit. */
+
+  size_t length;                                /* Length of converted. */
+
+
+  if (total <= ULONG_MAX) {
+    print_stat("soucet", (unsigned long) total, max_unit);
+    return;
+  }
+
+  do {
+    *--p_digit = (char) ('0' + (int) (total % 10));
+    total /= 10;
+  } while (total != 0);
+
+  length = sprint_time_decimal(s_time, p_digit,
+                               (size_t) (digits + sizeof(digits) - p_digit),
+                               max_unit);
+
+  fprintf(stdout, "soucet: ");
+  fwrite(s_time, sizeof(char), length, stdout);
+
+  return;
+}
+
+
+/******************************************************************************
+ ***[END OF PROJ1STATS.C]******************************************************
+ ******************************************************************************/
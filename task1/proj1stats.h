@@ -0,0 +1,106 @@
+/**
+ * File:          proj1stats.h
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #1 - Time entry conversion
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This header file contains functional prototypes of functions
+ *                of proj1stats.c module and structure of statistics of input
+ *                values used alongside them.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj1.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ1STATS.H]***************************************************
+ ******************************************************************************/
+
+/*
+ * Safety mechanism against multi-including of of this .h file.
+ */
+#ifndef PROJ1STATS_H
+
+#define PROJ1STATS_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "proj1timeconv.h"
+
+
+/******************************************************************************
+ ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Type of the total of values, which is at least twice as wide as unsigned
+ * long where possible, so the total of ULONG_MAX values can't overflow. GCC
+ * compatible compilers provide 128 bit integer on 64 bit targets, on 32 bit
+ * targets unsigned long long is wide enough. (__extension__ keeps -pedantic
+ * quiet.) STATS_TOTAL_WIDE is defined, if the total can't overflow.
+ */
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 TU_Total;
+  #define STATS_TOTAL_WIDE
+#elif ULONG_MAX < ULLONG_MAX
+  typedef unsigned long long TU_Total;
+  #define STATS_TOTAL_WIDE
+#else
+  typedef unsigned long TU_Total;
+#endif
+
+
+/*
+ * Structure containing statistics of processed values. Percentiles are
+ * computed either exactly from all stored values, or approximately from the
+ * sketch - histogram of fixed number of logarithmic buckets.
+ */
+typedef struct stats {
+  TE_Max_unit max_unit;         /* Maximum time unit. */
+
+  unsigned long count;          /* Number of values. */
+  TU_Total total;               /* Sum of values. */
+  unsigned long min;            /* Minimal value. */
+  unsigned long max;            /* Maximal value. */
+
+  /* Numbers of values by their highest nonzero unit (up to max_unit). */
+  unsigned long units[WEEKS + 1];
+
+  bool sketch;                  /* Are the percentiles approximated? */
+
+  unsigned long *p_values;      /* Stored values (exact percentiles). */
+  size_t size;                  /* Size of memory of stored values. */
+
+  unsigned long *p_buckets;     /* Buckets of the sketch. */
+} TS_Stats;
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF GLOBAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+int stats_init(TS_Stats *p_stats, TE_Max_unit max_unit, bool sketch);
+void stats_free(TS_Stats *p_stats);
+
+int stats_add(TS_Stats *p_stats, const unsigned long *p_in, size_t n);
+
+void stats_print(TS_Stats *p_stats);
+
+#endif
+
+/******************************************************************************
+ ***[END OF PROJ1STATS.H]******************************************************
+ ******************************************************************************/
@@ -41,6 +41,16 @@
 
 #include "proj1timeconv.h"
 
+/*
+ * AVX2 version of process_time_values() is compiled only for x86 processors
+ * with GCC compatible compiler, which supports function specific targets. The
+ * use of it is decided at run time.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define TIMECONV_AVX2
+  #include <immintrin.h>
+#endif
+
 
 /******************************************************************************
  ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -65,10 +75,60 @@ static const unsigned long HOUR_SECS = 3600;
 static const unsigned long MIN_SECS = 60;
 
 /*
- * Maximum characters of longest word which can be printed (including trailing
- * '\0'). The longest actual word is 'seconds' in Czech.
+ * Reciprocal multipliers and shifts used for division of remainders, which are
+ * lower than WEEK_SECS (they fit into 20 bits): x / DAY_SECS equals to
+ * (x * DAY_MUL) >> DAY_SHIFT and so on. The results were verified for every
+ * value lower than 2^20.
+ */
+#define DAY_MUL 795365ULL
+#define DAY_SHIFT 36
+
+#define HOUR_MUL 1193047ULL
+#define HOUR_SHIFT 32
+
+#define MIN_MUL 559241ULL
+#define MIN_SHIFT 25
+
+/*
+ * Number of decimal digits, which can be always stored in unsigned long.
+ */
+#if ULONG_MAX > 0xFFFFFFFFUL
+  #define ULONG_DIGITS 19LU
+#else
+  #define ULONG_DIGITS 9LU
+#endif
+
+/*
+ * Functions specialized for given max_unit are generated from one inline
+ * function, which has to be inlined, so the tests of the constant max_unit
+ * are evaluated at the compile time.
+ */
+#ifdef __GNUC__
+  #define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+  #define ALWAYS_INLINE inline
+#endif
+
+/*
+ * Helpful macro for definition of converter specialized for given max_unit.
+ * See convert_values() for more information.
  */
-static const int MAX_CHARS = 8;
+#define DEFINE_CONVERTER(name, max_unit) \
+  static void name(const unsigned long *p_in, TS_Time *p_out, size_t n) \
+  { \
+    convert_values(p_in, p_out, n, (max_unit)); \
+    return; \
+  }
+
+/*
+ * Helpful macro for definition of sprint_time_value() function specialized for
+ * given max_unit. See sprint_units() for more information.
+ */
+#define DEFINE_SPRINTER(name, max_unit) \
+  static int name(char *p_str, TS_Time *p_time) \
+  { \
+    return (int) (sprint_units(p_str, p_str, p_time, (max_unit)) - p_str); \
+  }
 
 
 /******************************************************************************
@@ -76,43 +136,211 @@ static const int MAX_CHARS = 8;
  ******************************************************************************/
 
 /*
- * Field containing endings for Czech words hours, minutes, seconds
- * corresponding to Czech language cases.
- */
-static char * const hms_endings[MAX_ELEMENTS] = {
-  "",
-  "a",
-  "y",
-  "y", 
-  "y",
+ * Structure containing one fully inflected unit name prepared for copying. The
+ * name is preceded by the space separating it from the value of the unit.
+ */
+typedef struct unit_name {
+  const char *p_str;            /* Inflected name (with leading space). */
+  size_t length;                /* Length of the name (without '\0'). */
+} TS_Unit_name;
+
+
+/*
+ * Helpful macro for initialization of TS_Unit_name structure from string
+ * literal, so the length doesn't have to be counted manually.
+ */
+#define UNIT_NAME(str) { (str), sizeof(str) - 1 }
+
+
+/*
+ * Field containing Czech names of seconds, minutes, hours, days and weeks with
+ * endings corresponding to Czech language cases. First index is the unit, the
+ * second is the bucket given by the value of the unit - values from 0 to
+ * MAX_ELEMENTS - 1 have their own bucket, every other value uses the bucket
+ * of DEFAULT_ENDING. (There's an empty line for indexing starting from number
+ * 1, see TE_Max_unit.) These names are printed by default and they are also
+ * the only ones recognized by scan_time_value().
+ */
+static const TS_Unit_name czech_names[][MAX_ELEMENTS] = {
+  [SECONDS] = {
+    UNIT_NAME(" sekund"),
+    UNIT_NAME(" sekunda"),
+    UNIT_NAME(" sekundy"),
+    UNIT_NAME(" sekundy"),
+    UNIT_NAME(" sekundy"),
+  },
+
+  [MINUTES] = {
+    UNIT_NAME(" minut"),
+    UNIT_NAME(" minuta"),
+    UNIT_NAME(" minuty"),
+    UNIT_NAME(" minuty"),
+    UNIT_NAME(" minuty"),
+  },
+
+  [HOURS] = {
+    UNIT_NAME(" hodin"),
+    UNIT_NAME(" hodina"),
+    UNIT_NAME(" hodiny"),
+    UNIT_NAME(" hodiny"),
+    UNIT_NAME(" hodiny"),
+  },
+
+  [DAYS] = {
+    UNIT_NAME(" dnu"),
+    UNIT_NAME(" den"),
+    UNIT_NAME(" dny"),
+    UNIT_NAME(" dny"),
+    UNIT_NAME(" dny"),
+  },
+
+  [WEEKS] = {
+    UNIT_NAME(" tydnu"),
+    UNIT_NAME(" tyden"),
+    UNIT_NAME(" tydny"),
+    UNIT_NAME(" tydny"),
+    UNIT_NAME(" tydny"),
+  },
 };
 
 
 /*
- * Field containing endings for Czech words weeks and days which have other
- * endings than words higher.
- */
-static char * const wd_endings[MAX_ELEMENTS] = {
-  "nu",
-  "en",
-  "ny",
-  "ny",
-  "ny",
+ * Maximal number of plural forms of one unit name in any supported language
+ * and maximal length of one name including the leading space and '\0'.
+ */
+#define MAX_FORMS 3LU
+#define MAX_NAME_LEN 16LU
+
+
+/*
+ * Structure containing plural rules of one language. Every unit has up to
+ * MAX_FORMS forms of its' name (without leading space) and the plural rule
+ * gives the index of the form for every bucket of units_names field. Values
+ * bigger than MAX_ELEMENTS - 1 use the bucket of DEFAULT_ENDING, so the rule
+ * has to give the same form for all of them in every supported language.
+ */
+typedef struct locale {
+  const char *p_code;                         /* Code of the language. */
+  const char *forms[WEEKS + 1][MAX_FORMS];    /* Forms of units names. */
+  unsigned char plural[MAX_ELEMENTS];         /* Form of every bucket. */
+} TS_Locale;
+
+
+/*
+ * Field of plural rules of every supported language, see select_locale().
+ * Slovak and Czech use the form for 1, the form for 2 to 4 and the form for
+ * other values, English and German use only singular for 1 and plural for
+ * other values.
+ */
+static const TS_Locale locales[] = {
+  {
+    .p_code = "cs",
+    .forms = {
+      [SECONDS] = { "sekund", "sekunda", "sekundy" },
+      [MINUTES] = { "minut", "minuta", "minuty" },
+      [HOURS]   = { "hodin", "hodina", "hodiny" },
+      [DAYS]    = { "dnu", "den", "dny" },
+      [WEEKS]   = { "tydnu", "tyden", "tydny" },
+    },
+    .plural = { 0, 1, 2, 2, 2 },
+  },
+
+  {
+    .p_code = "sk",
+    .forms = {
+      [SECONDS] = { "sekund", "sekunda", "sekundy" },
+      [MINUTES] = { "minut", "minuta", "minuty" },
+      [HOURS]   = { "hodin", "hodina", "hodiny" },
+      [DAYS]    = { "dni", "den", "dni" },
+      [WEEKS]   = { "tyzdnov", "tyzden", "tyzdne" },
+    },
+    .plural = { 0, 1, 2, 2, 2 },
+  },
+
+  {
+    .p_code = "en",
+    .forms = {
+      [SECONDS] = { "seconds", "second" },
+      [MINUTES] = { "minutes", "minute" },
+      [HOURS]   = { "hours", "hour" },
+      [DAYS]    = { "days", "day" },
+      [WEEKS]   = { "weeks", "week" },
+    },
+    .plural = { 0, 1, 0, 0, 0 },
+  },
+
+  {
+    .p_code = "de",
+    .forms = {
+      [SECONDS] = { "Sekunden", "Sekunde" },
+      [MINUTES] = { "Minuten", "Minute" },
+      [HOURS]   = { "Stunden", "Stunde" },
+      [DAYS]    = { "Tage", "Tag" },
+      [WEEKS]   = { "Wochen", "Woche" },
+    },
+    .plural = { 0, 1, 0, 0, 0 },
+  },
 };
 
 
 /*
- * Field containing unit names. There's an empty string for indexing starting
- * from number 1. (See function prepare_time_value() for more information.)
- * Then there are roots of Czech words seconds, minutes, hours, days, weeks.
- */
-static char * const units_names[] = {
-  "",
-  "sekund",
-  "minut",
-  "hodin",
-  "d",
-  "tyd",
+ * Names of the language selected by select_locale(), expanded from its' plural
+ * rules into the same flat form as czech_names field, and memory of them.
+ */
+static TS_Unit_name locale_names[WEEKS + 1][MAX_ELEMENTS];
+static char locale_strs[WEEKS + 1][MAX_ELEMENTS][MAX_NAME_LEN];
+
+
+/*
+ * Names of units used for printing, Czech ones until another language is
+ * selected. Printing of the name is only indexing of this field regardless of
+ * the language.
+ */
+static const TS_Unit_name (*units_names)[MAX_ELEMENTS] = czech_names;
+
+
+/*
+ * Entry of the hash table of inflected unit names used by scan_time_value().
+ * Empty entries contain NULL instead of the name.
+ */
+typedef struct name_entry {
+  const TS_Unit_name *p_name;   /* Inflected name from czech_names field. */
+  TE_Max_unit unit;             /* Unit of the name. */
+} TS_Name_entry;
+
+
+/*
+ * Helpful macro for computing of the perfect hash of inflected unit name
+ * (without leading space) of given length. Every name from czech_names field
+ * has its' own entry in names_hash field below.
+ */
+#define NAMES_HASH_SIZE 32LU
+
+#define NAME_HASH(p_str, length) \
+  (((length) + (unsigned char) (p_str)[0] \
+    + 6 * (unsigned char) (p_str)[(length) - 1]) & (NAMES_HASH_SIZE - 1))
+
+
+/*
+ * Perfect hash table of every different inflected name from czech_names field,
+ * indexed by NAME_HASH() macro. Lookup of the name takes only one comparison.
+ */
+static const TS_Name_entry names_hash[NAMES_HASH_SIZE] = {
+  [0]  = { &czech_names[SECONDS][1], SECONDS },  /* sekunda */
+  [1]  = { &czech_names[HOURS][0], HOURS },      /* hodin */
+  [4]  = { &czech_names[HOURS][2], HOURS },      /* hodiny */
+  [5]  = { &czech_names[DAYS][0], DAYS },        /* dnu */
+  [9]  = { &czech_names[MINUTES][2], MINUTES },  /* minuty */
+  [10] = { &czech_names[MINUTES][0], MINUTES },  /* minut */
+  [13] = { &czech_names[WEEKS][1], WEEKS },      /* tyden */
+  [15] = { &czech_names[WEEKS][2], WEEKS },      /* tydny */
+  [16] = { &czech_names[SECONDS][2], SECONDS },  /* sekundy */
+  [17] = { &czech_names[SECONDS][0], SECONDS },  /* sekund */
+  [20] = { &czech_names[HOURS][1], HOURS },      /* hodina */
+  [23] = { &czech_names[WEEKS][0], WEEKS },      /* tydnu */
+  [25] = { &czech_names[MINUTES][1], MINUTES },  /* minuta */
+  [27] = { &czech_names[DAYS][1], DAYS },        /* den */
+  [29] = { &czech_names[DAYS][2], DAYS },        /* dny */
 };
 
 
@@ -130,17 +358,74 @@ typedef struct uldiv_t {
  ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
 
-static void prepare_time_value(unsigned long value, char *p_unit_name,
-                               TE_Max_unit unit);
-
 static TS_Uldiv_t uldiv(unsigned long numer, unsigned long denom);
 
+static inline unsigned long split_top(unsigned long seconds,
+                                      TE_Max_unit max_unit,
+                                      unsigned long long *p_rem);
+
+static inline void split_rem(unsigned long long rem, TS_Time *p_time,
+                             TE_Max_unit max_unit);
+
+static inline void set_top(unsigned long value, TS_Time *p_time,
+                           TE_Max_unit max_unit);
+
+#ifdef TIMECONV_AVX2
+__attribute__((target("avx2")))
+static ALWAYS_INLINE size_t convert_values_avx2(const unsigned long *p_in,
+                                                TS_Time *p_out, size_t n,
+                                                TE_Max_unit max_unit);
+
+__attribute__((target("avx2")))
+static size_t convert_weeks_avx2(const unsigned long *p_in, TS_Time *p_out,
+                                 size_t n);
+
+__attribute__((target("avx2")))
+static size_t convert_days_avx2(const unsigned long *p_in, TS_Time *p_out,
+                                size_t n);
+#endif
+
+static ALWAYS_INLINE void convert_values(const unsigned long *p_in,
+                                         TS_Time *p_out, size_t n,
+                                         TE_Max_unit max_unit);
+
+static ALWAYS_INLINE char *sprint_units(char *p_str, char *p_act,
+                                        TS_Time *p_time, TE_Max_unit max_unit);
+
+static inline char *sprint_unit(char *p_str, char *p_act,
+                                unsigned long value, TE_Max_unit unit);
+
+static inline unsigned long unit_seconds(TE_Max_unit unit);
+
 /*
  * NOTE: Declarations of other (PRIMARY) functions can be found in
  *       "proj1timeconv.h" header file.
  */
 
 
+/******************************************************************************
+ ~~~[ SPECIALIZED FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Converters for every max_unit, see select_converter().
+ */
+DEFINE_CONVERTER(convert_weeks, WEEKS)
+DEFINE_CONVERTER(convert_days, DAYS)
+DEFINE_CONVERTER(convert_hours, HOURS)
+DEFINE_CONVERTER(convert_minutes, MINUTES)
+DEFINE_CONVERTER(convert_seconds, SECONDS)
+
+/*
+ * Versions of sprint_time_value() for every lower max_unit than WEEKS, see
+ * select_sprinter().
+ */
+DEFINE_SPRINTER(sprint_days, DAYS)
+DEFINE_SPRINTER(sprint_hours, HOURS)
+DEFINE_SPRINTER(sprint_minutes, MINUTES)
+DEFINE_SPRINTER(sprint_seconds, SECONDS)
+
+
 /******************************************************************************
  ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
@@ -282,97 +567,378 @@ TS_Time process_time_value(unsigned long seconds, TE_Max_unit max_unit)
 
 
 /**
- * Function prints correctly content of given TS_Time structure corresponding
- * to Czech grammar to stdout. The 0 values in TS_Time structure are skipped,
- * others are printed. If every value in given structure is 0, then prints
- * default value (0 seconds).
+ * Batch version of process_time_value() function. It converts n values from
+ * the field p_in and stores the results into the field p_out by converter
+ * specialized for given max_unit (see select_converter()). Results are same as
+ * results of process_time_value(), including errno set to EINVAL for wrong
+ * max_unit.
  */
-void print_time_value(TS_Time *p_time)
+void process_time_values(const unsigned long *p_in, TS_Time *p_out, size_t n,
+                         TE_Max_unit max_unit)
 {
-  char s_unit_name[MAX_CHARS];  /* Helpful string used for printing. */
+  TF_Converter p_convert = select_converter(max_unit);
 
-  bool print_space = false;     /* Needed for skipping of first space char. */
+  /* Wrong value of max_unit, zeros are returned. */
+  if (p_convert == NULL) {
+    for (size_t i = 0; i < n; i++)
+      p_out[i] = (TS_Time) {.secs = 0, .mins = 0, .hours = 0, .days = 0,
+                            .weeks = 0};
 
-  int printed_chars = 0;        /* The actual value of printed characters. */
+    return;
+  }
 
-  int *p_printed_chars = &printed_chars;  /* Pointer used by printf(). */
+  p_convert(p_in, p_out, n);
 
-  unsigned long value = 0;      /* Actual value for printing. */
+  return;
+}
 
-  TE_Max_unit unit;             /* Helpful enumerate unit for iterating. */
 
- 
-  /*
-   * Goes through every element of TS_Time structure and if it's a nonzero 
-   * value, then prints it properly in human readable form.
-   */ 
-  for (unit = WEEKS; unit >= SECONDS; unit--) {
-    
-    /*
-     * Assigning correct value from given TS_Time structure.
-     */
-    switch (unit) {
-    
-      case WEEKS :
-        value = p_time->weeks;
-        break;
+/**
+ * Returns the batch converter of values specialized for given max_unit, which
+ * can be selected only once instead of testing max_unit for every value. The
+ * highest unit is divided by its' constant, every lower unit is computed from
+ * the remainder by multiplying it by reciprocal value (see DAY_MUL etc.) and
+ * only the units lower than max_unit are computed. If the processor supports
+ * AVX2 instructions, then the remainders of days and weeks converters are
+ * processed 4 at once. Returns NULL and sets errno to EINVAL for wrong
+ * max_unit.
+ */
+TF_Converter select_converter(TE_Max_unit max_unit)
+{
+  switch (max_unit) {
 
-      case DAYS :
-        value = p_time->days;
-        break;
+    case WEEKS :
+      return convert_weeks;
 
-      case HOURS :
-        value = p_time->hours;
-        break;
+    case DAYS :
+      return convert_days;
+
+    case HOURS :
+      return convert_hours;
 
-      case MINUTES :
-        value = p_time->mins;
-        break;
+    case MINUTES :
+      return convert_minutes;
+
+    case SECONDS :
+      return convert_seconds;
 
-      case SECONDS :
-        value = p_time->secs;
-        break;
+    default :
+      errno = EINVAL;
+      return NULL;
+  }
+}
 
-      default :
-        break;
 
+/**
+ * Returns the version of sprint_time_value() function specialized for given
+ * max_unit. It skips the units higher than max_unit, because they can never
+ * be nonzero in values converted with the same max_unit. Returns NULL and sets
+ * errno to EINVAL for wrong max_unit.
+ */
+TF_Sprinter select_sprinter(TE_Max_unit max_unit)
+{
+  switch (max_unit) {
+
+    case WEEKS :
+      return sprint_time_value;
+
+    case DAYS :
+      return sprint_days;
+
+    case HOURS :
+      return sprint_hours;
+
+    case MINUTES :
+      return sprint_minutes;
+
+    case SECONDS :
+      return sprint_seconds;
+
+    default :
+      errno = EINVAL;
+      return NULL;
+  }
+}
+
+
+/**
+ * Selects the language of units names printed by sprint_time_value() and
+ * other printing functions by its' code (cs, sk, en or de). The names of every
+ * bucket are expanded from the plural rules of the language once, so printing
+ * of the name stays only indexing of the field. It has to be called before any
+ * printing (it's not thread safe). Returns EXIT_SUCCESS, or EXIT_FAILURE and
+ * sets errno to EINVAL for unknown code.
+ */
+int select_locale(const char *p_code)
+{
+  const TS_Locale *p_locale = NULL;   /* Selected language. */
+
+  for (size_t i = 0; i < sizeof(locales) / sizeof(locales[0]); i++) {
+    if (strcmp(locales[i].p_code, p_code) == 0) {
+      p_locale = &locales[i];
+      break;
     }
-        
-    if (value == 0)         /* Zero value -> nothing to print. */
-      continue;
-  
-    /*
-     * Preparation of Czech word and its' ending for printing. Result is stored
-     * in helpful string s_unit_name.
-     */
-    prepare_time_value(value, s_unit_name, unit);
-
-    if (print_space == true)
-      fprintf(stdout, " ");
-    
-    /*
-     * Prints the value of actual unit and name of the unit. Also stores the
-     * number of printed characters in printed_chars variable.
-     */
-    fprintf(stdout, "%lu %s%n", value, s_unit_name, p_printed_chars);
-    
-    print_space = true;     /* 1st printing is done, print space next time. */
   }
-  
+
+  if (p_locale == NULL) {
+    errno = EINVAL;
+    return EXIT_FAILURE;
+  }
+
+  for (int unit = SECONDS; unit <= WEEKS; unit++) {
+    for (size_t bucket = 0; bucket < MAX_ELEMENTS; bucket++) {
+      const char *p_form = p_locale->forms[unit][p_locale->plural[bucket]];
+      char *p_name = locale_strs[unit][bucket];
+
+      p_name[0] = ' ';                /* Space separating the value. */
+      strncpy(p_name + 1, p_form, MAX_NAME_LEN - 2);
+      p_name[MAX_NAME_LEN - 1] = '\0';
+
+      locale_names[unit][bucket].p_str = p_name;
+      locale_names[unit][bucket].length = strlen(p_name);
+    }
+  }
+
+  units_names = (const TS_Unit_name (*)[MAX_ELEMENTS]) locale_names;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Function stores correctly content of given TS_Time structure corresponding
+ * to Czech grammar (or grammar of language given by select_locale()) into
+ * given string, which has to be at least MAX_TIME_STR characters long. The 0
+ * values in TS_Time structure are skipped, others are stored. If every value
+ * in given structure is 0, then stores default value (0 seconds). The string
+ * is terminated by '\n' and '\0'. Returns the number of stored characters
+ * (without the trailing '\0').
+ */
+int sprint_time_value(char *p_str, TS_Time *p_time)
+{
+  return (int) (sprint_units(p_str, p_str, p_time, WEEKS) - p_str);
+}
+
+
+/**
+ * Wide version of sprint_time_value() for number of seconds of any size, which
+ * is given as string of length decimal digits (only digits are allowed). The
+ * number is converted with given max_unit and stored into given string, which
+ * has to be at least length + MAX_TIME_STR characters long. Number, which can
+ * be stored in unsigned long, is converted by process_time_value() (decimal
+ * fast path). Bigger number is divided by the seconds of max_unit digit by
+ * digit, so the value of the highest unit is stored straight as decimal
+ * string and only the remainder is converted. Returns the number of stored
+ * characters (without the trailing '\0'). Wrong max_unit is handled same as
+ * by process_time_value().
+ */
+size_t sprint_time_decimal(char *p_str, const char *p_digits, size_t length,
+                           TE_Max_unit max_unit)
+{
+  const TS_Unit_name *p_name;   /* Inflected name of the highest unit. */
+
+  char *p_act = p_str;          /* Actual position in given string. */
+
+  unsigned long value = 0;      /* Value of number, which fits. */
+  unsigned long divisor;        /* Seconds of max_unit. */
+  unsigned long rem = 0;        /* Remainder of the division. */
+  unsigned long digit;          /* Actual digit of the quotient. */
+
+  TS_Time time;                 /* Converted (remainder of) number. */
+
+
+  /* Leading zeros skipping. */
+  while (length > 0 && *p_digits == '0') {
+    p_digits++;
+    length--;
+  }
+
+  if (length <= ULONG_DIGITS || max_unit < SECONDS || max_unit > WEEKS) {
+
+    for (size_t i = 0; i < length && i < ULONG_DIGITS; i++)
+      value = value * 10 + (unsigned long) (p_digits[i] - '0');
+
+    time = process_time_value(value, max_unit);
+
+    return (size_t) (sprint_units(p_str, p_str, &time, WEEKS) - p_str);
+  }
 
   /*
-   * Prints the default value if no printing was performed. (Zeros in whole
-   * structure.)
+   * Long division of the number, every digit of the quotient is lower than 10,
+   * because the remainder is lower than the divisor.
    */
-  if (printed_chars == 0)
-    fprintf(stdout, "0 sekund");
+  divisor = unit_seconds(max_unit);
+
+  for (size_t i = 0; i < length; i++) {
+    rem = rem * 10 + (unsigned long) (p_digits[i] - '0');
+    digit = rem / divisor;
+    rem -= digit * divisor;
+
+    if (p_act != p_str || digit != 0)
+      *p_act++ = (char) ('0' + digit);
+  }
+
+  /* Quotient is never zero, the number is bigger than ULONG_MAX. */
+  if (p_act - p_str == 1 && (unsigned long) (*p_str - '0') < MAX_ELEMENTS)
+    p_name = &units_names[max_unit][*p_str - '0'];
+  else
+    p_name = &units_names[max_unit][DEFAULT_ENDING];
+
+  memcpy(p_act, p_name->p_str, p_name->length);
+  p_act += p_name->length;
+
+  /* Remainder has zero in max_unit, so only lower units are stored. */
+  time = process_time_value(rem, max_unit);
+
+  return (size_t) (sprint_units(p_str, p_act, &time, max_unit) - p_str);
+}
+
+
+/**
+ * Function prints correctly content of given TS_Time structure corresponding
+ * to Czech grammar to stdout. See sprint_time_value() for more information.
+ */
+void print_time_value(TS_Time *p_time)
+{
+  char s_time[MAX_TIME_STR];    /* Helpful string used for printing. */
+
+  int length = sprint_time_value(s_time, p_time);
 
-  fprintf(stdout, "\n");
+  fwrite(s_time, sizeof(char), (size_t) length, stdout);
     
   return;
 }
 
 
+/**
+ * Stores decimal representation of given unsigned long value into given string
+ * without the trailing '\0' and returns pointer to the character following the
+ * last stored digit. Digits are generated from the lowest one into the helpful
+ * field first, so no reversing is needed afterwards.
+ */
+char *ultostr(unsigned long value, char *p_str)
+{
+  char digits[sizeof(unsigned long) * CHAR_BIT];  /* Helpful field. */
+
+  char *p_digit = digits + sizeof(digits);        /* Position of last digit. */
+
+  do {
+    *--p_digit = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+
+  size_t length = (size_t) (digits + sizeof(digits) - p_digit);
+
+  memcpy(p_str, p_digit, length);
+
+  return p_str + length;
+}
+
+
+/**
+ * Function inverts sprint_time_value() - it converts given string of length
+ * characters (without the trailing '\n') containing time value in Czech form,
+ * e.g. "3 dny 4 hodiny 5 sekund", back to number of seconds, which is stored
+ * by given pointer. Every inflection of unit names is accepted, units have to
+ * be separated by single space and sorted from the highest one. Returns
+ * EXIT_SUCCESS or EXIT_FAILURE and sets errno to EDOM for wrong format or to
+ * EOVERFLOW if the value cannot be stored in unsigned long.
+ */
+int scan_time_value(const char *p_str, size_t length, unsigned long *p_seconds)
+{
+  /* Helpful values for overflow testing, same as in readtoul(). */
+  const unsigned long max_val_quo = ULONG_MAX / 10;
+  const unsigned long max_val_rem = ULONG_MAX % 10;
+
+  const char *p_act = p_str;              /* Actual position in string. */
+  const char *p_end = p_str + length;     /* End of the string. */
+  const char *p_word;                     /* Start of unit name. */
+
+  const TS_Name_entry *p_entry;           /* Entry of found unit name. */
+
+  unsigned long total = 0;                /* Actual number of seconds. */
+  unsigned long value;                    /* Value of actual unit. */
+  unsigned long secs;                     /* Seconds of actual unit. */
+  unsigned long digit;                    /* Actual digit. */
+
+  int last = WEEKS + 1;                   /* Previous unit. */
+
+  size_t word_len;                        /* Length of unit name. */
+
+
+  errno = ESUCCESS;
+  *p_seconds = 0;
+
+  /*
+   * Processing of pairs "<value> <unit name>" one by one.
+   */
+  while (true) {
+
+    value = 0;
+    p_word = p_act;
+
+    while (p_act < p_end && (digit = (unsigned long) (*p_act - '0')) <= 9) {
+
+      if (value > max_val_quo
+          || (value == max_val_quo && digit > max_val_rem)) {
+        errno = EOVERFLOW;    /* Value too big to be stored in given type. */
+        return EXIT_FAILURE;
+      }
+
+      value = value * 10 + digit;
+      p_act++;
+    }
+
+    /* The value has to be followed by a space and the name of unit. */
+    if (p_act == p_word || p_act == p_end || *p_act++ != ' ') {
+      errno = EDOM;
+      return EXIT_FAILURE;
+    }
+
+    p_word = p_act;
+
+    while (p_act < p_end && *p_act != ' ')
+      p_act++;
+
+    word_len = (size_t) (p_act - p_word);
+
+    if (word_len == 0) {
+      errno = EDOM;
+      return EXIT_FAILURE;
+    }
+
+    /* Lookup of the name, units have to be sorted from the highest one. */
+    p_entry = &names_hash[NAME_HASH(p_word, word_len)];
+
+    if (p_entry->p_name == NULL || p_entry->p_name->length - 1 != word_len
+        || memcmp(p_entry->p_name->p_str + 1, p_word, word_len) != 0
+        || (int) p_entry->unit >= last) {
+      errno = EDOM;
+      return EXIT_FAILURE;
+    }
+
+    last = (int) p_entry->unit;
+    secs = unit_seconds(p_entry->unit);
+
+    if (value > (ULONG_MAX - total) / secs) {
+      errno = EOVERFLOW;      /* Sum too big to be stored in given type. */
+      return EXIT_FAILURE;
+    }
+
+    total += value * secs;
+
+    if (p_act == p_end)       /* Last unit. */
+      break;
+
+    p_act++;                  /* Skipping the separating space. */
+  }
+
+  *p_seconds = total;
+
+  return EXIT_SUCCESS;
+}
+
+
 /******************************************************************************
  ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
@@ -394,88 +960,373 @@ static TS_Uldiv_t uldiv(unsigned long numer, unsigned long denom)
 
 
 /**
- * Function prepares string for printing which contains Czech name of
- * corresponding unit and its' ending given by the value of the unit. The result
- * is stored in string by given pointer. Function uses static global fields of
- * this module.
+ * Divides given seconds by the number of seconds of max_unit. Returns the
+ * quotient and stores the remainder by given pointer. For SECONDS the whole
+ * value is returned and the remainder is zero. Only valid max_unit can be
+ * used.
  */
-static void prepare_time_value(unsigned long value, char *p_unit_name,
-                               TE_Max_unit unit)
+static inline unsigned long split_top(unsigned long seconds,
+                                      TE_Max_unit max_unit,
+                                      unsigned long long *p_rem)
 {
-  char *p_unit_ending = NULL;   /* Helpful pointer to corresponding ending. */
+  unsigned long quot;         /* Helpful quotient. */
 
-  /*
-   * Prepares string for printing by determining which unit is being print and
-   * assigning correct word ending. Then prints the results into given string.
-   */
-  switch (unit) {
-    
-    /* Weeks & days uses wd_endings field. The rest of code is similar. */
-    case WEEKS : {
-      if (value < MAX_ELEMENTS)
-        p_unit_ending = wd_endings[value];
-      else
-        p_unit_ending = wd_endings[DEFAULT_ENDING];
+  switch (max_unit) {
+
+    case WEEKS :
+      quot = seconds / WEEK_SECS;
+      *p_rem = seconds - quot * WEEK_SECS;
+      return quot;
+
+    case DAYS :
+      quot = seconds / DAY_SECS;
+      *p_rem = seconds - quot * DAY_SECS;
+      return quot;
+
+    case HOURS :
+      quot = seconds / HOUR_SECS;
+      *p_rem = seconds - quot * HOUR_SECS;
+      return quot;
+
+    case MINUTES :
+      quot = seconds / MIN_SECS;
+      *p_rem = seconds - quot * MIN_SECS;
+      return quot;
+
+    default :
+      *p_rem = 0;
+      return seconds;
+  }
+}
+
+
+/**
+ * Converts remainder lower than the number of seconds of max_unit into lower
+ * units of given TS_Time structure using reciprocal multipliers. Other units
+ * are set to zero.
+ */
+static inline void split_rem(unsigned long long rem, TS_Time *p_time,
+                             TE_Max_unit max_unit)
+{
+  unsigned long long quot;    /* Helpful quotient. */
+
+  *p_time = (TS_Time) {.secs = 0, .mins = 0, .hours = 0, .days = 0,
+                       .weeks = 0};
+
+  switch (max_unit) {
+
+    case WEEKS :
+      quot = (rem * DAY_MUL) >> DAY_SHIFT;
+      rem -= quot * DAY_SECS;
+      p_time->days = (unsigned long) quot;
+      /* FALLTHROUGH */
 
-      snprintf(p_unit_name, MAX_CHARS,
-               "%s%s", units_names[WEEKS], p_unit_ending);
+    case DAYS :
+      quot = (rem * HOUR_MUL) >> HOUR_SHIFT;
+      rem -= quot * HOUR_SECS;
+      p_time->hours = (unsigned long) quot;
+      /* FALLTHROUGH */
+
+    case HOURS :
+      quot = (rem * MIN_MUL) >> MIN_SHIFT;
+      rem -= quot * MIN_SECS;
+      p_time->mins = (unsigned long) quot;
+      /* FALLTHROUGH */
+
+    case MINUTES :
+      p_time->secs = (unsigned long) rem;
       break;
-    }
 
-    case DAYS : {
-      if (value < MAX_ELEMENTS)
-        p_unit_ending = wd_endings[value];
-      else
-        p_unit_ending = wd_endings[DEFAULT_ENDING];
+    default :
+      break;
+  }
+
+  return;
+}
+
+
+/**
+ * Stores value of the highest unit into corresponding element of given TS_Time
+ * structure. Remainder of the highest unit is always lower than its' number of
+ * seconds, so the element was zero before.
+ */
+static inline void set_top(unsigned long value, TS_Time *p_time,
+                           TE_Max_unit max_unit)
+{
+  switch (max_unit) {
 
-      snprintf(p_unit_name, MAX_CHARS,
-               "%s%s", units_names[DAYS], p_unit_ending);
+    case WEEKS :
+      p_time->weeks = value;
       break;
-    }
-    
-    /* Hours, minutes and seconds uses hms_endings field. */
-    case HOURS : {
-      if (value < MAX_ELEMENTS)
-        p_unit_ending = hms_endings[value];
-      else
-        p_unit_ending = hms_endings[DEFAULT_ENDING];
 
-      snprintf(p_unit_name, MAX_CHARS,
-               "%s%s", units_names[HOURS], p_unit_ending);
+    case DAYS :
+      p_time->days = value;
       break;
-    }
 
-    case MINUTES : {
-      if (value < MAX_ELEMENTS)
-        p_unit_ending = hms_endings[value];
-      else
-        p_unit_ending = hms_endings[DEFAULT_ENDING];
+    case HOURS :
+      p_time->hours = value;
+      break;
+
+    case MINUTES :
+      p_time->mins = value;
+      break;
 
-      snprintf(p_unit_name, MAX_CHARS,
-               "%s%s", units_names[MINUTES], p_unit_ending);
+    default :
+      p_time->secs = value;
       break;
+  }
+
+  return;
+}
+
+
+/**
+ * Converts n values from the field p_in into the field p_out for given
+ * max_unit. It is inlined into converters generated by DEFINE_CONVERTER macro,
+ * so max_unit is constant and the code for units higher than max_unit is
+ * omitted. Weeks and days are converted by AVX2 version of this function, if
+ * the processor supports it.
+ */
+static ALWAYS_INLINE void convert_values(const unsigned long *p_in,
+                                         TS_Time *p_out, size_t n,
+                                         TE_Max_unit max_unit)
+{
+  size_t i = 0;                 /* Number of processed values. */
+
+  unsigned long long rem;       /* Remainder after division of highest unit. */
+
+  unsigned long top;            /* Value of the highest unit. */
+
+
+#ifdef TIMECONV_AVX2
+  if ((max_unit == WEEKS || max_unit == DAYS)
+      && __builtin_cpu_supports("avx2"))
+    i = (max_unit == WEEKS) ? convert_weeks_avx2(p_in, p_out, n)
+                            : convert_days_avx2(p_in, p_out, n);
+#endif
+
+  /* Scalar processing of the rest of values. */
+  for (; i < n; i++) {
+    top = split_top(p_in[i], max_unit, &rem);
+    split_rem(rem, &p_out[i], max_unit);
+    set_top(top, &p_out[i], max_unit);
+  }
+
+  return;
+}
+
+
+#ifdef TIMECONV_AVX2
+/**
+ * AVX2 version of convert_values() for WEEKS and DAYS max_unit. The highest
+ * unit is divided in scalar way (there's no 64 bit high multiplication in
+ * AVX2), then 4 remainders are converted at once by the same reciprocal
+ * multipliers as in split_rem(). Returns number of processed values, which is
+ * n rounded down to multiple of 4.
+ */
+__attribute__((target("avx2")))
+static ALWAYS_INLINE size_t convert_values_avx2(const unsigned long *p_in,
+                                                TS_Time *p_out, size_t n,
+                                                TE_Max_unit max_unit)
+{
+  unsigned long long rem[4];    /* Remainders of highest unit. */
+  unsigned long long days[4];   /* Results of vector computation. */
+  unsigned long long hours[4];
+  unsigned long long mins[4];
+  unsigned long long secs[4];
+
+  unsigned long top[4];         /* Values of the highest unit. */
+
+  const __m256i day_mul = _mm256_set1_epi64x((long long) DAY_MUL);
+  const __m256i hour_mul = _mm256_set1_epi64x((long long) HOUR_MUL);
+  const __m256i min_mul = _mm256_set1_epi64x((long long) MIN_MUL);
+
+  const __m256i day_secs = _mm256_set1_epi64x((long long) DAY_SECS);
+  const __m256i hour_secs = _mm256_set1_epi64x((long long) HOUR_SECS);
+  const __m256i min_secs = _mm256_set1_epi64x((long long) MIN_SECS);
+
+  __m256i v_rem;                /* Vector of remainders. */
+  __m256i v_quot;               /* Vector of quotients. */
+
+  size_t i;
+
+
+  for (i = 0; i + 4 <= n; i += 4) {
+
+    for (int j = 0; j < 4; j++)
+      top[j] = split_top(p_in[i + j], max_unit, &rem[j]);
+
+    v_rem = _mm256_loadu_si256((__m256i *) rem);
+
+    /* Remainders fit into 32 bits, so only lower halves are multiplied. */
+    if (max_unit == WEEKS) {
+      v_quot = _mm256_srli_epi64(_mm256_mul_epu32(v_rem, day_mul), DAY_SHIFT);
+      v_rem = _mm256_sub_epi64(v_rem, _mm256_mul_epu32(v_quot, day_secs));
+      _mm256_storeu_si256((__m256i *) days, v_quot);
     }
 
-    case SECONDS : {
-      if (value < MAX_ELEMENTS)
-        p_unit_ending = hms_endings[value];
-      else
-        p_unit_ending = hms_endings[DEFAULT_ENDING];
+    v_quot = _mm256_srli_epi64(_mm256_mul_epu32(v_rem, hour_mul), HOUR_SHIFT);
+    v_rem = _mm256_sub_epi64(v_rem, _mm256_mul_epu32(v_quot, hour_secs));
+    _mm256_storeu_si256((__m256i *) hours, v_quot);
 
-      snprintf(p_unit_name, MAX_CHARS,
-               "%s%s", units_names[SECONDS], p_unit_ending);
-      break;
+    v_quot = _mm256_srli_epi64(_mm256_mul_epu32(v_rem, min_mul), MIN_SHIFT);
+    v_rem = _mm256_sub_epi64(v_rem, _mm256_mul_epu32(v_quot, min_secs));
+    _mm256_storeu_si256((__m256i *) mins, v_quot);
+
+    _mm256_storeu_si256((__m256i *) secs, v_rem);
+
+    for (int j = 0; j < 4; j++) {
+      p_out[i + j].weeks = 0;
+      p_out[i + j].days = (max_unit == WEEKS) ? (unsigned long) days[j] : 0;
+      p_out[i + j].hours = (unsigned long) hours[j];
+      p_out[i + j].mins = (unsigned long) mins[j];
+      p_out[i + j].secs = (unsigned long) secs[j];
+
+      set_top(top[j], &p_out[i + j], max_unit);
     }
+  }
+
+  return i;
+}
+
+
+/**
+ * AVX2 versions of convert_values() specialized for WEEKS and DAYS max_unit.
+ * The processor support has to be tested before calling them.
+ */
+__attribute__((target("avx2")))
+static size_t convert_weeks_avx2(const unsigned long *p_in, TS_Time *p_out,
+                                 size_t n)
+{
+  return convert_values_avx2(p_in, p_out, n, WEEKS);
+}
+
+
+__attribute__((target("avx2")))
+static size_t convert_days_avx2(const unsigned long *p_in, TS_Time *p_out,
+                                size_t n)
+{
+  return convert_values_avx2(p_in, p_out, n, DAYS);
+}
+#endif
+
+
+/**
+ * Stores the content of given TS_Time structure into given string at position
+ * p_act, same as sprint_time_value(), but only the units up to max_unit are
+ * tested. Characters from p_str to p_act were already stored by the caller.
+ * Returns the position of the trailing '\0'. It is inlined into functions
+ * generated by DEFINE_SPRINTER macro and into sprint_time_value(), so max_unit
+ * is constant and the code for higher units is omitted.
+ */
+static ALWAYS_INLINE char *sprint_units(char *p_str, char *p_act,
+                                        TS_Time *p_time, TE_Max_unit max_unit)
+{
+  const TS_Unit_name *p_name;   /* Inflected name of default value. */
+
+
+  /*
+   * Jumps over to wanted case given by max_unit, every lower unit is stored
+   * then, if it's a nonzero value.
+   */
+  switch (max_unit) {
+
+    case WEEKS :
+      p_act = sprint_unit(p_str, p_act, p_time->weeks, WEEKS);
+      /* FALLTHROUGH */
+
+    case DAYS :
+      p_act = sprint_unit(p_str, p_act, p_time->days, DAYS);
+      /* FALLTHROUGH */
+
+    case HOURS :
+      p_act = sprint_unit(p_str, p_act, p_time->hours, HOURS);
+      /* FALLTHROUGH */
+
+    case MINUTES :
+      p_act = sprint_unit(p_str, p_act, p_time->mins, MINUTES);
+      /* FALLTHROUGH */
+
+    case SECONDS :
+      p_act = sprint_unit(p_str, p_act, p_time->secs, SECONDS);
+      break;
 
-    /*
-     * Default case for avoiding warnings, that NOT_DEF & HELP are not
-     * processed in the switch.
-     */
     default :
-      break;     
+      break;
   }
 
-  return;
+
+  /*
+   * Stores the default value if nothing was stored. (Zeros in whole
+   * structure.)
+   */
+  if (p_act == p_str) {
+    p_name = &units_names[SECONDS][DEFAULT_ENDING];
+
+    *p_act++ = '0';
+    memcpy(p_act, p_name->p_str, p_name->length);
+    p_act += p_name->length;
+  }
+
+  *p_act++ = '\n';
+  *p_act = '\0';
+
+  return p_act;
+}
+
+
+/**
+ * Stores given value of given unit with the name of the unit (in selected
+ * language) corresponding to the value at position p_act of string p_str, if
+ * the value is nonzero. The 1st stored unit is not preceded by space. Returns
+ * the position following the stored characters.
+ */
+static inline char *sprint_unit(char *p_str, char *p_act,
+                                unsigned long value, TE_Max_unit unit)
+{
+  const TS_Unit_name *p_name;   /* Inflected name of the unit. */
+
+  if (value == 0)               /* Zero value -> nothing to print. */
+    return p_act;
+
+  if (value < MAX_ELEMENTS)
+    p_name = &units_names[unit][value];
+  else
+    p_name = &units_names[unit][DEFAULT_ENDING];
+
+  if (p_act != p_str)           /* 1st unit is not preceded by space. */
+    *p_act++ = ' ';
+
+  p_act = ultostr(value, p_act);
+
+  memcpy(p_act, p_name->p_str, p_name->length);
+
+  return p_act + p_name->length;
+}
+
+
+/**
+ * Returns number of seconds of given unit. Only valid unit can be used.
+ */
+static inline unsigned long unit_seconds(TE_Max_unit unit)
+{
+  switch (unit) {
+
+    case WEEKS :
+      return WEEK_SECS;
+
+    case DAYS :
+      return DAY_SECS;
+
+    case HOURS :
+      return HOUR_SECS;
+
+    case MINUTES :
+      return MIN_SECS;
+
+    default :
+      return 1;
+  }
 }
 
 
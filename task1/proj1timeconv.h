@@ -34,6 +34,9 @@
 
 #define PROJ1TIMECONV_H
 
+/* Type size_t is used by process_time_values() and others below. */
+#include <stddef.h>
+
 
 /******************************************************************************
  ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -41,6 +44,13 @@
 
 #define ESUCCESS 0                  /* Value representing errno == 0. */
 
+/*
+ * Maximum length of one formatted time value including the trailing '\n' and
+ * '\0'. Every unit can take at most 20 digits, 1 space, 8 characters of its
+ * name (in any language) and 1 separating space. The rest is reserve.
+ */
+#define MAX_TIME_STR 256
+
 
 /******************************************************************************
  ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -73,6 +83,21 @@ typedef struct time {
 } TS_Time;
 
 
+/*
+ * Batch converter of values specialized for one max_unit, see
+ * select_converter().
+ */
+typedef void (*TF_Converter)(const unsigned long *p_in, TS_Time *p_out,
+                             size_t n);
+
+
+/*
+ * Function with interface of sprint_time_value() specialized for one
+ * max_unit, see select_sprinter().
+ */
+typedef int (*TF_Sprinter)(char *p_str, TS_Time *p_time);
+
+
 /******************************************************************************
  ~~~[ FUNCTIONAL PROTOTYPES OF PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
@@ -81,8 +106,26 @@ int readtoul(unsigned long *p_num);
 
 TS_Time process_time_value(unsigned long seconds, TE_Max_unit max_unit);
 
+void process_time_values(const unsigned long *p_in, TS_Time *p_out, size_t n,
+                         TE_Max_unit max_unit);
+
+TF_Converter select_converter(TE_Max_unit max_unit);
+
+TF_Sprinter select_sprinter(TE_Max_unit max_unit);
+
+int select_locale(const char *p_code);
+
+int sprint_time_value(char *p_str, TS_Time *p_time);
+
+size_t sprint_time_decimal(char *p_str, const char *p_digits, size_t length,
+                           TE_Max_unit max_unit);
+
 void print_time_value(TS_Time *p_time);
 
+char *ultostr(unsigned long value, char *p_str);
+
+int scan_time_value(const char *p_str, size_t length, unsigned long *p_seconds);
+
 #endif
 
 /******************************************************************************
@@ -31,6 +31,9 @@
  ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
 
+/* POSIX isatty() is used for detection of interactive input. */
+#define _POSIX_C_SOURCE 200809L
+
 #include <errno.h>
 #include <float.h>
 #include <math.h>
@@ -39,9 +42,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "proj2_bufio.h"
 #include "proj2_mathlib.h"
 #include "proj2_geomlib.h"
+#include "proj2_parallel.h"
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Number of values read and computed at once by func_caller(). */
+#define FUNC_BATCH 1024
+
 
 /******************************************************************************
  ~~~[ LOCAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -81,26 +95,52 @@ typedef struct arguments {
   int sigdig;               /* Required significant digits. */
   double err_val;           /* Value of absolute error. */
   double base;              /* Base of logarithm. */
+
+  TE_Format in_format;      /* Format of input values. */
+  TE_Format out_format;     /* Format of output values. */
+
+  int threads;              /* Number of threads, -1 if not used. */
 } TS_Arguments;
 
 /* Declaration of pointer to function. */
-typedef double (*p_fd)(double x, ...);
+typedef double (*p_fd)(double x, int sigdig);
 
 /* Field of pointers to function. */
 static p_fd const func_field[] = {
-  [ARC_COS] = arc_cosine,
-  [ARC_COT] = arc_cotangent,
-  [ARC_SIN] = arc_sine,
-  [ARC_TAN] = arc_tangent,
-  [COS]     = cosine,
-  [EXP]     = expn,
-  [HYP_COS] = hyper_cosine,
-  [HYP_COT] = hyper_cotangent,
-  [HYP_SIN] = hyper_sine,
-  [HYP_TAN] = hyper_tangent,
-  [LN]      = ln,
-  [SIN]     = sine,
-  [SQRT]    = sqrroot,
+  [ARC_COS] = arc_cosine_p,
+  [ARC_COT] = arc_cotangent_p,
+  [ARC_SIN] = arc_sine_p,
+  [ARC_TAN] = arc_tangent_p,
+  [COS]     = cosine_p,
+  [EXP]     = expn_p,
+  [HYP_COS] = hyper_cosine_p,
+  [HYP_COT] = hyper_cotangent_p,
+  [HYP_SIN] = hyper_sine_p,
+  [HYP_TAN] = hyper_tangent_p,
+  [LN]      = ln_p,
+  [SIN]     = sine_p,
+  [SQRT]    = sqrroot_p,
+};
+
+/* Declaration of pointer to batch function. */
+typedef void (*p_fb)(const double *p_x, double *p_y, int *p_err, size_t n,
+                     int sigdig);
+
+/* Field of pointers to batch versions of functions above. */
+static p_fb const batch_field[] = {
+  [ARC_COS] = arc_cosine_batch,
+  [ARC_COT] = arc_cotangent_batch,
+  [ARC_SIN] = arc_sine_batch,
+  [ARC_TAN] = arc_tangent_batch,
+  [COS]     = cosine_batch,
+  [EXP]     = expn_batch,
+  [HYP_COS] = hyper_cosine_batch,
+  [HYP_COT] = hyper_cotangent_batch,
+  [HYP_SIN] = hyper_sine_batch,
+  [HYP_TAN] = hyper_tangent_batch,
+  [LN]      = ln_batch,
+  [SIN]     = sine_batch,
+  [SQRT]    = sqrroot_batch,
 };
 
 /******************************************************************************
@@ -110,8 +150,12 @@ static p_fd const func_field[] = {
 void print_help(char *prog_name);
 int process_args(int argc, char *argv[], TS_Arguments *p_args);
 
-int lbl_w(void);
-int lble_w(double errval);
+int lbl_w(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff);
+int lble_w(double errval, TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff);
+int logax_w(double base, int sigdig, TS_Inbuffer *p_inbuff,
+            TS_Outbuffer *p_outbuff);
+int func_w(TS_Arguments *p_args, TS_Inbuffer *p_inbuff,
+           TS_Outbuffer *p_outbuff);
 
 int func_caller(TS_Arguments *p_args);
 
@@ -161,8 +205,19 @@ void print_help(char *prog_name)
   "\n"
   "        err                specifies the absolute error value of --lble\n"
   "\n"
+  "Format of input and output values can follow the specifiers:\n"
+  "      --in-format=FMT      reads values in format FMT\n"
+  "      --out-format=FMT     writes values in format FMT\n"
+  "        FMT                is 'text' (default) or 'f64' for raw "
+  "little-endian\n"
+  "                           doubles (--lbl and --lble read x,y pairs)\n"
+  "      --threads N          computes values by N threads, 0 stands for\n"
+  "                           number of processors (except --lble and\n"
+  "                           --logax), --lbl sums are compensated then\n"
+  "\n"
   "Exact order of the parameters is required, in this format:\n"
-  "  [--OPTION] [SIGDIG] [BASE/ERR]\n"
+  "  [--OPTION] [SIGDIG] [BASE/ERR] [--in-format=FMT] [--out-format=FMT]\n"
+  "  [--threads N]\n"
   "\n"
   "Examples:\n"
   "  %s --logax 10 2.71\n"
@@ -296,6 +351,54 @@ int process_args(int argc, char *argv[], TS_Arguments *p_args)
     i++;
   }
 
+  /* Formats of input and output values and number of threads. */
+  for (; i < argc; i++) {
+    TE_Format *p_format;
+    const char *p_value;
+
+    if (strcmp("--threads", argv[i]) == 0 && p_args->threads == -1
+        && i + 1 < argc) {
+      i++;
+      errno = 0;
+      endptr = NULL;
+
+      long threads = strtol(argv[i], &endptr, 10);
+
+      if (errno != 0 || *endptr != '\0' || endptr == argv[i]
+          || threads < 0 || threads > MAX_THREADS) {
+        errno = EINVAL;
+        return EXIT_FAILURE;
+      }
+
+      p_args->threads = (int) threads;
+      continue;
+    }
+    else if (strncmp("--in-format=", argv[i], strlen("--in-format=")) == 0) {
+      p_format = &p_args->in_format;
+      p_value = argv[i] + strlen("--in-format=");
+    }
+    else if (strncmp("--out-format=", argv[i], strlen("--out-format=")) == 0) {
+      p_format = &p_args->out_format;
+      p_value = argv[i] + strlen("--out-format=");
+    }
+    else
+      break;
+
+    if (strcmp("text", p_value) == 0)
+      *p_format = FORMAT_TEXT;
+    else if (strcmp("f64", p_value) == 0)
+      *p_format = FORMAT_F64;
+    else
+      break;                            /* Unknown format. */
+  }
+
+  /* Threads are used only for functions from func_field and for lbl. */
+  if (p_args->threads != -1
+      && (p_args->func == LBLE || p_args->func == LOGAX)) {
+    errno = EINVAL;
+    return EXIT_FAILURE;
+  }
+
   /* Enough arguments? */
   if (i < argc) {
     errno = EINVAL;
@@ -312,94 +415,79 @@ int process_args(int argc, char *argv[], TS_Arguments *p_args)
 
 /**
  * Wrapper function for computing length of broken line. It gets value from
- * stdin, computes new value and prints it until EOF. Uses lbl() function and
- * TS_Lobl structure.
+ * stdin, computes new value and prints it until EOF. Points are read and
+ * computed in batches of FUNC_BATCH points by lbl_batch() function, unless the
+ * input is interactive (then they are computed one by one). Uses TS_Lobl
+ * structure.
  */
-int lbl_w(void)
+int lbl_w(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff)
 {
   bool print_warn = true;       /* Prints warning only once. */
+  bool first = true;            /* Is the first point going to be read? */
 
   TS_Lobl lobl = {              /* Initialization. */
     .sum = 0.0,
   };
 
-  int scan_res;                 /* Return value of fscanf. */
+  double x[FUNC_BATCH];         /* Coordinates of x. */
+  double y[FUNC_BATCH];         /* Coordinates of y. */
+  double sum[FUNC_BATCH];       /* Sums after each point. */
+  int err[FUNC_BATCH];          /* Errno values of the computation. */
+  int scan_err[FUNC_BATCH];     /* Errno values of the reading. */
+  bool nan_in[FUNC_BATCH];      /* Was any input value not a number? */
 
-  errno = 0;
-  scan_res = fscanf(stdin, "%lf %lf", &lobl.x_act, &lobl.y_act);
+  bool eof = false;             /* Was the end of input reached? */
+  int read_err = 0;             /* Errno value of reading. */
 
-  /* Rest of initialization. */
-  lobl.x_bef = lobl.x_act;
-  lobl.y_bef = lobl.y_act;
-  
-  /* Repeats if there's still something to read. */
-  while (scan_res != EOF) {
-  
-    /* Read values handling. */
-    switch (scan_res) {
-      
-      /* Matching failure of first input value. */
-      case 0 :
+  /* Points typed on terminal are computed immediately. */
+  size_t batch = (isatty(STDIN_FILENO)) ? 1 : FUNC_BATCH;
 
-        /* Skipping the values. */
-        scan_res = fscanf(stdin, "%*s %*s");
-
-        /* Wrong value == NaN (wrong input). */
-        lobl.x_act = NAN;
-        lobl.y_act = NAN;
-
-        /* Warning. */
-        if (print_warn == true) {
-          fprintf(stderr, "proj2: warning: Some input values "
-                          "are not a number!\n");
-          print_warn = false;
-        }
-        
-        break;
-
-      /* Matching failure on second input value. */
-      case 1 :
-        /* Skipping the wrong value. */
-        scan_res = fscanf(stdin, "%*s");
-
-        /* Wrong value == NaN (wrong input). */
-        lobl.y_act = NAN;
-
-        /* Warning. */
-        if (print_warn == true) {
-          fprintf(stderr, "proj2: warning: Some input values "
-                          "are not a number!\n");
-          print_warn = false;
-        }
+  /* Repeats if there's still something to read. */
+  do {
+    size_t n = breadpoints(p_inbuff, x, y, scan_err, nan_in, batch, &eof);
 
-        break;
+    if (eof == true)
+      read_err = errno;
 
-      /* None of above, proceed. */
-      default :
-        break;
+    /* Rest of initialization, the first point has no predecessor. */
+    if (first == true && n > 0) {
+      lobl.x_bef = x[0];
+      lobl.y_bef = y[0];
+      first = false;
     }
-    
+
     /* Compute new values. */
-    lbl(&lobl);
-    
-    /* Warning upon computation error. */
-    if (errno != 0 && print_warn == true) {
-      fprintf(stderr, "proj2: warning: %s\n", strerror(errno));
-      print_warn = false;
+    lbl_batch(&lobl, x, y, sum, err, n);
+
+    for (size_t i = 0; i < n; i++) {
+
+      /* Warning upon wrong input. */
+      if (nan_in[i] == true && print_warn == true) {
+        fprintf(stderr, "proj2: warning: Some input values "
+                        "are not a number!\n");
+        print_warn = false;
+      }
+
+      /* Warning upon computation (or reading) error. */
+      int err_val = (err[i] != 0) ? err[i] : scan_err[i];
+
+      if (err_val != 0 && print_warn == true) {
+        fprintf(stderr, "proj2: warning: %s\n", strerror(err_val));
+        print_warn = false;
+      }
+
+      /* Print of result, writing error stops the computation. */
+      if (bwriteval(p_outbuff, sum[i]) == EXIT_FAILURE) {
+        perror("proj2");
+        return EXIT_FAILURE;
+      }
     }
-    
-    /* Print of result. */
-    fprintf(stdout, "%.10e\n", lobl.sum);
-
-    /* Reseting errno. */
-    errno = 0;
 
-    /* Get new values. */
-    scan_res = fscanf(stdin, "%lf %lf", &lobl.x_act, &lobl.y_act);
-  }
+  } while (eof == false);
 
   /* Error upon read? */
-  if (errno != 0) {
+  if (read_err != 0) {
+    errno = read_err;
     perror("proj2");
     return EXIT_FAILURE;
   }
@@ -412,7 +500,7 @@ int lbl_w(void)
  * Same function as lbl_w, but this uses lble() function for computing lehgth
  * of broken line with absolute error value.
  */
-int lble_w(double err_val)
+int lble_w(double err_val, TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff)
 {
   bool print_warn = true;       /* Prints warning only once. */
 
@@ -422,10 +510,10 @@ int lble_w(double err_val)
     .sum_max = 0.0,
   };
 
-  int scan_res;                 /* Return value of fscanf. */
+  int scan_res;                 /* Return value of reading. */
 
   errno = 0;
-  scan_res = fscanf(stdin, "%lf %lf", &loblwe.x_act, &loblwe.y_act);
+  scan_res = breadpair(p_inbuff, &loblwe.x_act, &loblwe.y_act);
 
   /* Rest of initialization. */
   loblwe.x_bef_min = loblwe.x_act - err_val;
@@ -445,7 +533,10 @@ int lble_w(double err_val)
       case 0 :
 
         /* Skipping the values. */
-        scan_res = fscanf(stdin, "%*s %*s");
+        scan_res = bskipval(p_inbuff);
+
+        if (scan_res != EOF)
+          bskipval(p_inbuff);
 
         /* Wrong value == NaN (wrong input). */
         loblwe.x_act = NAN;
@@ -464,7 +555,7 @@ int lble_w(double err_val)
       case 1 :
 
         /* Skipping the wrong value. */
-        scan_res = fscanf(stdin, "%*s");
+        scan_res = bskipval(p_inbuff);
 
         /* Wrong value == NaN (wrong input). */
         loblwe.y_act = NAN;
@@ -493,15 +584,18 @@ int lble_w(double err_val)
       print_warn = false;
     }
     
-    /* Print of results. */
-    fprintf(stdout, "%.10e\n", loblwe.sum_min);
-    fprintf(stdout, "%.10e\n", loblwe.sum_max);
+    /* Print of results, writing error stops the computation. */
+    if (bwriteval(p_outbuff, loblwe.sum_min) == EXIT_FAILURE
+        || bwriteval(p_outbuff, loblwe.sum_max) == EXIT_FAILURE) {
+      perror("proj2");
+      return EXIT_FAILURE;
+    }
 
     /* Reseting errno. */
     errno = 0;
 
     /* Get new value. */
-    scan_res = fscanf(stdin, "%lf %lf", &loblwe.x_act, &loblwe.y_act);
+    scan_res = breadpair(p_inbuff, &loblwe.x_act, &loblwe.y_act);
   }
   
   /* Error upon read? */
@@ -518,36 +612,46 @@ int lble_w(double err_val)
  * Wrapper function for logax. Gets value and prints result in a loop until end
  * of file.
  */
-int logax_w(double base, int sigdig)
+int logax_w(double base, int sigdig, TS_Inbuffer *p_inbuff,
+            TS_Outbuffer *p_outbuff)
 {
   double x;                             /* Input value. */
   int scan_res;                         /* Scan result. */
 
   errno = 0;                            /* Reseting errno. */
 
-  scan_res = fscanf(stdin, "%lf", &x);
+  scan_res = breadval(p_inbuff, &x);
   
   /* Loop until end of input or error. */
   while (scan_res != EOF) {
 
+    int err = 0;                        /* Errno value of the result. */
+
     if (scan_res == 1) {
       /* Correct value loaded. */
       errno = 0;
-      fprintf(stdout, "%.10e\n", logax(x, base, sigdig));
-
-      if (errno != 0)
-        fprintf(stderr, "proj2: warning: %s\n", strerror(errno));
+      x = logax_p(x, base, sigdig);
+      err = errno;
     }
     else {
       /* Invalid value loaded. */
-      fprintf(stdout, "%.10e\n", NAN);
+      x = NAN;
 
       /* Skip to next value. */
-      scan_res = fscanf(stdin, "%*s");
+      scan_res = bskipval(p_inbuff);
     }
+
+    /* Writing error stops the computation. */
+    if (bwriteval(p_outbuff, x) == EXIT_FAILURE) {
+      perror("proj2");
+      return EXIT_FAILURE;
+    }
+
+    if (err != 0)
+      fprintf(stderr, "proj2: warning: %s\n", strerror(err));
     
     errno = 0;
-    scan_res = fscanf(stdin, "%lf", &x);
+    scan_res = breadval(p_inbuff, &x);
   }
   
   /* Error upon read? */
@@ -558,75 +662,186 @@ int logax_w(double base, int sigdig)
   else
     return EXIT_SUCCESS;
 }
+
+
+/**
+ * Wrapper function for functions from func_field. Values are read and
+ * computed in batches of FUNC_BATCH values by their batch versions, unless the
+ * input is interactive (then they are computed one by one). Invalid values are
+ * computed as NaN. Binary input values are passed to the batch versions
+ * without copying, when it's possible.
+ */
+int func_w(TS_Arguments *p_args, TS_Inbuffer *p_inbuff,
+           TS_Outbuffer *p_outbuff)
+{
+  double x[FUNC_BATCH];                 /* Input values. */
+  double y[FUNC_BATCH];                 /* Results. */
+  int err[FUNC_BATCH];                  /* Errno values of results. */
+
+  int scan_res;                         /* Scan result. */
+  int read_err = 0;                     /* Errno value of reading. */
+
+  /* Values typed on terminal are computed immediately. */
+  size_t batch = (isatty(STDIN_FILENO)) ? 1 : FUNC_BATCH;
+
+  /* Loop until end of input or error. */
+  do {
+    size_t n = 0;                       /* Number of read values. */
+    const double *p_x = x;              /* Values to compute. */
+
+    /* Binary values are computed right from the input buffer. */
+    if (p_inbuff->format == FORMAT_F64) {
+      errno = 0;
+      n = breadf64_block(p_inbuff, &p_x, x, batch);
+
+      scan_res = (n == 0) ? EOF : 1;
+      read_err = (n == 0) ? errno : 0;
+    }
+
+    /* Reading of the batch until it's full or until end of input. */
+    while (p_inbuff->format == FORMAT_TEXT && n < batch) {
+      errno = 0;                        /* Reseting errno. */
+
+      scan_res = breadval(p_inbuff, &x[n]);
+
+      if (scan_res == EOF) {
+        read_err = errno;
+        break;
+      }
+
+      if (scan_res != 1) {
+        /* Invalid value loaded. */
+        x[n] = NAN;
+
+        /* Skip to next value. */
+        scan_res = bskipval(p_inbuff);
+      }
+
+      n++;
+    }
+
+    /* Interactive values are computed one by one. */
+    if (batch == 1 && n == 1) {
+      errno = 0;
+      y[0] = func_field[p_args->func](p_x[0], p_args->sigdig);
+      err[0] = errno;
+    }
+    else
+      batch_field[p_args->func](p_x, y, err, n, p_args->sigdig);
+
+    for (size_t i = 0; i < n; i++) {
+
+      /* Writing error stops the computation. */
+      if (bwriteval(p_outbuff, y[i]) == EXIT_FAILURE) {
+        perror("proj2");
+        return EXIT_FAILURE;
+      }
+
+      if (err[i] != 0)
+        fprintf(stderr, "proj2: warning: %s\n", strerror(err[i]));
+    }
+
+  } while (scan_res != EOF);
+  
+  /* Error upon read? */
+  if (read_err != 0) {
+    errno = read_err;
+    perror("proj2");
+    return EXIT_FAILURE;
+  }
+  else
+    return EXIT_SUCCESS;
+}
+
+
 /******************************************************************************
  ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
 
 /**
- * General function which calls appropriate required function.
+ * General function which calls appropriate required function. Input and
+ * output are processed by blocks through the buffers of proj2_bufio.c module,
+ * which are shared by all the wrapper functions. Values are read and written
+ * in the formats given by calling parameters.
  */
 int func_caller(TS_Arguments *p_args)
 {
-  switch (p_args->func) {
+  /* This shouldn't happen. */
+  if (p_args->func == HELP)
+    return EXIT_FAILURE;
 
-    /* This shouldn't happen. */
-    case HELP :
-      return EXIT_FAILURE;
+  TS_Inbuffer inbuff;                   /* Buffer of stdin. */
+  TS_Outbuffer outbuff;                 /* Buffer of stdout. */
+
+  if (inbuff_init(&inbuff, stdin, p_args->in_format) == EXIT_FAILURE) {
+    perror("proj2");
+    return EXIT_FAILURE;
+  }
+
+  /* Binary file is mapped into memory, other streams are read normally. */
+  if (p_args->in_format == FORMAT_F64)
+    inbuff_map(&inbuff);
+
+  if (outbuff_init(&outbuff, stdout, p_args->out_format) == EXIT_FAILURE) {
+    perror("proj2");
+    inbuff_free(&inbuff);
+    return EXIT_FAILURE;
+  }
+
+  int result;                           /* Return value of the wrapper. */
+
+  switch (p_args->func) {
 
     /* lbl() */
     case LBL :
-      return lbl_w();
+      if (p_args->threads == -1) {
+        result = lbl_w(&inbuff, &outbuff);
+        break;
+      }
+
+      result = process_lbl_mt(&inbuff, &outbuff, p_args->threads);
+
+      if (result == EXIT_FAILURE)
+        perror("proj2");
+
+      break;
     
     /* lble() */
     case LBLE :
-      return lble_w(p_args->err_val);
+      result = lble_w(p_args->err_val, &inbuff, &outbuff);
+      break;
 
     /* General logarithm. */
     case LOGAX :
-      return logax_w(p_args->base, p_args->sigdig);
+      result = logax_w(p_args->base, p_args->sigdig, &inbuff, &outbuff);
+      break;
 
     /* None of above, choose function from function field. */
     default :
-      break;
-  }
-  
-  double x;                             /* Input value. */
-  int scan_res;                         /* Scan result. */
-
-  errno = 0;                            /* Reseting errno. */
-
-  scan_res = fscanf(stdin, "%lf", &x);
-  
-  /* Loop until end of input or error. */
-  while (scan_res != EOF) {
+      if (p_args->threads == -1) {
+        result = func_w(p_args, &inbuff, &outbuff);
+        break;
+      }
 
-    if (scan_res == 1) {
-      /* Correct value loaded. */
-      errno = 0;
-      fprintf(stdout, "%.10e\n", func_field[p_args->func](x, p_args->sigdig));
+      result = process_values_mt(&inbuff, &outbuff, batch_field[p_args->func],
+                                 p_args->sigdig, p_args->threads);
 
-      if (errno != 0)
-        fprintf(stderr, "proj2: warning: %s\n", strerror(errno));
-    }
-    else {
-      /* Invalid value loaded. */
-      fprintf(stdout, "%.10e\n", NAN);
+      if (result == EXIT_FAILURE)
+        perror("proj2");
 
-      /* Skip to next value. */
-      scan_res = fscanf(stdin, "%*s");
-    }
-    
-    errno = 0;
-    scan_res = fscanf(stdin, "%lf", &x);
+      break;
   }
-  
-  /* Error upon read? */
-  if (errno != 0) {
+
+  /* Rest of the output, error of writing is reported only once. */
+  if (outbuff_flush(&outbuff) == EXIT_FAILURE && result == EXIT_SUCCESS) {
     perror("proj2");
-    return EXIT_FAILURE;
+    result = EXIT_FAILURE;
   }
-  else
-    return EXIT_SUCCESS;
+
+  inbuff_free(&inbuff);
+  outbuff_free(&outbuff);
+
+  return result;
 }
 
 /******************************************************************************
@@ -640,6 +855,9 @@ int main(int argc, char *argv[])
     .sigdig = 0.0,
     .err_val = -1.0,
     .base = 0.0,
+    .in_format = FORMAT_TEXT,
+    .out_format = FORMAT_TEXT,
+    .threads = -1,
   };
 
   /* Correct calling parameters? */
@@ -0,0 +1,1331 @@
+/**
+ * File:          proj2_bufio.c
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #2 - Iterative calculations
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This module contains functions for block reading and writing
+ *                of double values. It is used by proj2.c module instead of
+ *                fscanf("%lf") and fprintf("%.10e"), which are much slower
+ *                than the computation itself. Values are read and written in
+ *                the same format as by these functions, or as raw binary
+ *                doubles (then the input file can be memory-mapped).
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj2.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ2_BUFIO.C ]*************************************************
+ ******************************************************************************/
+
+/* Needed for read(), fileno(), isatty() and mmap() with -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "proj2_bufio.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Double-double value hi + lo, where |lo| is at most half of ulp of hi.
+ */
+typedef struct ddouble {
+  double hi;                /* Leading part of the value. */
+  double lo;                /* Rest of the value. */
+} TS_Ddouble;
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Size of input and output buffers. */
+static const size_t BUFF_SIZE_DEF = 262144;
+
+/* Maximal length of one value printed by bprint_double(), including '\n'. */
+#define MAX_DOUBLE_STR 32
+
+/*
+ * Number of decimal digits, which can be always stored in uint64_t without the
+ * overflow testing.
+ */
+static const int SAFE_DIGITS = 19;
+
+/* Biggest integer, up to which every integer is exactly representable. */
+static const uint64_t EXACT_INT_MAX = 9007199254740992ULL;      /* 2^53 */
+
+/* Exactly representable powers of 10 used by fast path of scan_double(). */
+#define EXACT_POW10_MAX 22
+
+static const double exact_pow10[EXACT_POW10_MAX + 1] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/* Value 2^27 + 1 used for Dekker's splitting of double, see dd_mul(). */
+static const double DEKKER_SPLIT = 134217729.0;
+
+/* Value of log10(2), used for estimation of decimal exponent. */
+static const double LOG10_2 = 0.30102999566398120;
+
+/*
+ * Decimal digits of value printed by sprint_double() are computed from
+ * a double-double product with error far below this value. Fractional part
+ * closer to 0.5 than this value is rounded by snprintf() instead.
+ */
+static const double ROUND_TIE_EPS = 1e-6;
+
+/* Number of digits printed after the decimal point, as of "%.10e". */
+#define PRINT_PREC 10
+
+/*
+ * Number of double-double powers of 10 below, which is enough for scaling of
+ * any double value into 11 decimal digits.
+ */
+#define POW10_DD_SIZE 9
+
+/* Values 10^(2^i) as double-double, see pow10_scale(). */
+static const TS_Ddouble pow10_pos[POW10_DD_SIZE] = {
+  {10.0, 0.0},                              /* 10^1 */
+  {100.0, 0.0},                             /* 10^2 */
+  {10000.0, 0.0},                           /* 10^4 */
+  {100000000.0, 0.0},                       /* 10^8 */
+  {1e+16, 0.0},                             /* 10^16 */
+  {1e+32, -5366162204393472.0},             /* 10^32 */
+  {1e+64, -2.1320419009454396e+47},         /* 10^64 */
+  {1e+128, -7.51744869165182e+111},         /* 10^128 */
+  {1e+256, -3.012765990014054e+239},        /* 10^256 */
+};
+
+/* Values 10^-(2^i) as double-double, see pow10_scale(). */
+static const TS_Ddouble pow10_neg[POW10_DD_SIZE] = {
+  {0.1, -5.551115123125783e-18},            /* 10^-1 */
+  {0.01, -2.0816681711721684e-19},          /* 10^-2 */
+  {0.0001, -4.79217360238593e-21},          /* 10^-4 */
+  {1e-08, -2.092256083012847e-25},          /* 10^-8 */
+  {1e-16, 2.0902213275965398e-33},          /* 10^-16 */
+  {1e-32, -5.59673099762419e-49},           /* 10^-32 */
+  {1e-64, 3.469426116645307e-81},           /* 10^-64 */
+  {1e-128, -5.401408859568103e-145},        /* 10^-128 */
+  {1e-256, 2.2671708827212437e-273},        /* 10^-256 */
+};
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+static size_t inbuff_more(TS_Inbuffer *p_inbuff);
+
+static bool inbuff_token(TS_Inbuffer *p_inbuff);
+
+static bool inbuff_bytes(TS_Inbuffer *p_inbuff, size_t n);
+
+static size_t inbuff_span(TS_Inbuffer *p_inbuff, size_t length, bool space);
+
+static bool inbuff_skips_next(TS_Inbuffer *p_inbuff, size_t length);
+
+static int outbuff_reserve(TS_Outbuffer *p_outbuff, size_t n);
+
+static const char *scan_word(const char *p_act, const char *p_word,
+                             bool *p_ok);
+
+static const char *scan_double(const char *p_act, double *p_num, bool *p_ok);
+
+static size_t sprint_double(char *p_dest, double num);
+
+static TS_Ddouble pow10_scale(double num, int exp10);
+
+static inline TS_Ddouble dd_mul(TS_Ddouble a, TS_Ddouble b);
+
+static inline double get_f64(const char *p_src);
+
+static inline void put_f64(char *p_dest, double num);
+
+static inline bool is_little_endian(void);
+
+static inline bool is_space(char c);
+
+static inline bool is_xdigit(char c);
+
+static inline char to_lower(char c);
+
+
+/******************************************************************************
+ ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Reads one value from given input buffer in the format of the buffer, by
+ * breadtod() or breadf64(). Return values are the same as of these functions.
+ */
+int breadval(TS_Inbuffer *p_inbuff, double *p_num)
+{
+  if (p_inbuff->format == FORMAT_F64)
+    return breadf64(p_inbuff, p_num);
+
+  return breadtod(p_inbuff, p_num);
+}
+
+
+/**
+ * Skips the rest of invalid value in given input buffer by bskipstr(). Binary
+ * values can't be invalid, so there's nothing to skip and EOF is returned.
+ */
+int bskipval(TS_Inbuffer *p_inbuff)
+{
+  if (p_inbuff->format == FORMAT_F64)
+    return EOF;
+
+  return bskipstr(p_inbuff);
+}
+
+
+/**
+ * Writes one value into given output buffer in the format of the buffer, by
+ * bprint_double() or bwritef64(). Return values are the same as of these
+ * functions.
+ */
+int bwriteval(TS_Outbuffer *p_outbuff, double num)
+{
+  if (p_outbuff->format == FORMAT_F64)
+    return bwritef64(p_outbuff, num);
+
+  return bprint_double(p_outbuff, num);
+}
+
+
+/**
+ * Same function as fscanf(stream, "%lf", p_num), but it reads the value from
+ * given input buffer, which is refilled by blocks from its' stream when needed.
+ * Returns 1 for read value, 0 for matching failure and EOF upon end of input
+ * or reading error (errno is set by read() then). Characters consumed upon
+ * matching failure are the same as of glibc's fscanf(), so the rest of invalid
+ * value can be skipped by bskipstr().
+ */
+int breadtod(TS_Inbuffer *p_inbuff, double *p_num)
+{
+  if (inbuff_token(p_inbuff) == false)
+    return EOF;
+
+  bool ok;                            /* Was the value read? */
+
+  const char *p_act = p_inbuff->p_data + p_inbuff->pos;
+  const char *p_end = scan_double(p_act, p_num, &ok);
+
+  p_inbuff->pos += (size_t) (p_end - p_act);
+
+  return (ok == true) ? 1 : 0;
+}
+
+
+/**
+ * Same function as fscanf(stream, "%lf %lf", p_x, p_y), but it reads the
+ * values from given input buffer by breadval(). Returns number of read values
+ * or EOF, if the end of input was reached before the first value.
+ */
+int breadpair(TS_Inbuffer *p_inbuff, double *p_x, double *p_y)
+{
+  int scan_res = breadval(p_inbuff, p_x);
+
+  if (scan_res != 1)
+    return scan_res;
+
+  return (breadval(p_inbuff, p_y) == 1) ? 2 : 1;
+}
+
+
+/**
+ * Reads up to n points (pairs of values) from given input buffer by
+ * breadpair(). Invalid values are skipped by bskipval() and stored as NaN,
+ * such points are marked in p_nan field. Errno value of reading of each point
+ * is stored into p_err. Returns number of read points and sets p_eof to true
+ * upon end of input, errno is set by the reading or to 0 then.
+ */
+size_t breadpoints(TS_Inbuffer *p_inbuff, double *p_x, double *p_y,
+                   int *p_err, bool *p_nan, size_t n, bool *p_eof)
+{
+  int scan_res;                         /* Return value of reading. */
+
+  for (size_t i = 0; i < n; i++) {
+    errno = 0;
+    scan_res = breadpair(p_inbuff, &p_x[i], &p_y[i]);
+
+    if (scan_res == EOF) {
+      *p_eof = true;
+      return i;
+    }
+
+    p_nan[i] = (scan_res != 2);
+
+    /* Read values handling. */
+    switch (scan_res) {
+
+      /* Matching failure of first input value, skipping the values. */
+      case 0 :
+        scan_res = bskipval(p_inbuff);
+
+        if (scan_res != EOF)
+          bskipval(p_inbuff);
+
+        p_x[i] = NAN;
+        p_y[i] = NAN;
+        break;
+
+      /* Matching failure on second input value, skipping the value. */
+      case 1 :
+        scan_res = bskipval(p_inbuff);
+        p_y[i] = NAN;
+        break;
+
+      /* None of above, proceed. */
+      default :
+        break;
+    }
+
+    p_err[i] = errno;
+
+    /* Skipping has reached the end of input. */
+    if (scan_res == EOF) {
+      *p_eof = true;
+      errno = 0;
+      return i + 1;
+    }
+  }
+
+  return n;
+}
+
+
+/**
+ * Same function as fscanf(stream, "%*s"), but it skips the characters in given
+ * input buffer. Returns 0 for skipped string and EOF upon end of input or
+ * reading error.
+ */
+int bskipstr(TS_Inbuffer *p_inbuff)
+{
+  if (inbuff_token(p_inbuff) == false)
+    return EOF;
+
+  /* Whole string is in the buffer already, see inbuff_token(). */
+  while (p_inbuff->pos < p_inbuff->used
+         && is_space(p_inbuff->p_data[p_inbuff->pos]) == false) {
+    p_inbuff->pos++;
+  }
+
+  return 0;
+}
+
+
+/**
+ * Same function as fprintf(stream, "%.10e\n", num), but it stores the text into
+ * given output buffer, which is flushed into its' stream when there's no space
+ * left for another value. Returns EXIT_SUCCESS or EXIT_FAILURE and sets errno,
+ * if the flushing of the buffer has failed.
+ */
+int bprint_double(TS_Outbuffer *p_outbuff, double num)
+{
+  if (outbuff_reserve(p_outbuff, MAX_DOUBLE_STR) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  p_outbuff->used += sprint_double(p_outbuff->p_data + p_outbuff->used, num);
+
+  /* Terminal output is line buffered same as stdout is. */
+  if (p_outbuff->line == true)
+    return outbuff_flush(p_outbuff);
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Reads one raw little-endian double from given input buffer. Returns 1 for
+ * read value and EOF upon end of input or reading error (errno is set by
+ * read() then). Incomplete value at the end of input is an error too, errno is
+ * set to EINVAL then.
+ */
+int breadf64(TS_Inbuffer *p_inbuff, double *p_num)
+{
+  if (inbuff_bytes(p_inbuff, BIN_VALUE_SIZE) == false)
+    return EOF;
+
+  *p_num = get_f64(p_inbuff->p_data + p_inbuff->pos);
+  p_inbuff->pos += BIN_VALUE_SIZE;
+
+  return 1;
+}
+
+
+/**
+ * Reads up to n raw little-endian doubles from given input buffer, at least
+ * one of them, unless the end of input was reached. Returns number of read
+ * values, 0 upon end of input or error (same as of breadf64()). Address of
+ * the values is stored into pp_values - on little-endian machine it points
+ * directly into the buffer (valid until next reading), otherwise the values
+ * are converted into p_dest.
+ */
+size_t breadf64_block(TS_Inbuffer *p_inbuff, const double **pp_values,
+                      double *p_dest, size_t n)
+{
+  if (inbuff_bytes(p_inbuff, BIN_VALUE_SIZE) == false)
+    return 0;
+
+  size_t avail = (p_inbuff->used - p_inbuff->pos) / BIN_VALUE_SIZE;
+
+  if (n > avail)
+    n = avail;
+
+  const char *p_act = p_inbuff->p_data + p_inbuff->pos;
+
+  p_inbuff->pos += n * BIN_VALUE_SIZE;
+
+  /* Values in the buffer are usable as they are? */
+  if (is_little_endian() == true && (uintptr_t) p_act % sizeof(double) == 0) {
+    *pp_values = (const double *) (const void *) p_act;
+    return n;
+  }
+
+  for (size_t i = 0; i < n; i++)
+    p_dest[i] = get_f64(p_act + i * BIN_VALUE_SIZE);
+
+  *pp_values = p_dest;
+  return n;
+}
+
+
+/**
+ * Stores the value into given output buffer as raw little-endian double.
+ * Returns EXIT_SUCCESS or EXIT_FAILURE and sets errno, if the flushing of the
+ * buffer has failed. Binary output is never flushed after every value.
+ */
+int bwritef64(TS_Outbuffer *p_outbuff, double num)
+{
+  if (outbuff_reserve(p_outbuff, BIN_VALUE_SIZE) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  put_f64(p_outbuff->p_data + p_outbuff->used, num);
+  p_outbuff->used += BIN_VALUE_SIZE;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the input buffer for given stream. The stream is read by
+ * read() function directly, so no stdio function can be used for reading of
+ * the stream afterwards. Values are read in given format. Returns EXIT_FAILURE
+ * and sets errno to ENOMEM, if the memory allocation has failed.
+ */
+int inbuff_init(TS_Inbuffer *p_inbuff, FILE *f_stream, TE_Format format)
+{
+  /* Buffer values initialization. */
+  p_inbuff->fd = fileno(f_stream);
+  p_inbuff->size = 0;
+  p_inbuff->used = 0;
+  p_inbuff->pos = 0;
+  p_inbuff->eof = false;
+  p_inbuff->mapped = false;
+  p_inbuff->format = format;
+
+  /* Buffer memory allocation, including the '\0' sentinel. */
+  p_inbuff->p_data = (char *) malloc((BUFF_SIZE_DEF + 1) * sizeof(char));
+
+  if (p_inbuff->p_data == NULL) {   /* Memory allocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_inbuff->size = BUFF_SIZE_DEF;   /* New size of buffer. */
+  p_inbuff->p_data[0] = '\0';
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Replaces the memory of initialized input buffer of binary values by the
+ * whole file of its' stream mapped into memory, so the values are not copied
+ * by read() at all. Reading continues from the current offset of the stream.
+ * Returns EXIT_FAILURE, if the stream isn't a regular file or it couldn't be
+ * mapped - the buffer stays usable for reading by read() then.
+ */
+int inbuff_map(TS_Inbuffer *p_inbuff)
+{
+  struct stat info;                   /* Information about the file. */
+
+  /* Mapped memory has no '\0' sentinel needed by the text parsing. */
+  if (p_inbuff->format != FORMAT_F64 || p_inbuff->mapped == true
+      || p_inbuff->used != 0) {
+    return EXIT_FAILURE;
+  }
+
+  if (fstat(p_inbuff->fd, &info) == -1 || S_ISREG(info.st_mode) == 0)
+    return EXIT_FAILURE;
+
+  off_t offset = lseek(p_inbuff->fd, 0, SEEK_CUR);
+
+  /* Nothing to map, the stream is read by read() normally. */
+  if (offset == -1 || offset >= info.st_size
+      || (uintmax_t) info.st_size > SIZE_MAX) {
+    return EXIT_FAILURE;
+  }
+
+  size_t length = (size_t) info.st_size;
+
+  void *p_map = mmap(NULL, length, PROT_READ, MAP_PRIVATE, p_inbuff->fd, 0);
+
+  if (p_map == MAP_FAILED)
+    return EXIT_FAILURE;
+
+  /* Only a hint, the result doesn't matter. */
+  posix_madvise(p_map, length, POSIX_MADV_SEQUENTIAL);
+
+  free((void *) p_inbuff->p_data);
+
+  p_inbuff->p_data = (char *) p_map;
+  p_inbuff->size = length;
+  p_inbuff->used = length;
+  p_inbuff->pos = (size_t) offset;
+  p_inbuff->eof = true;               /* Whole file is in the buffer. */
+  p_inbuff->mapped = true;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the input buffer over given memory of length characters
+ * with values in given format, no stream is read then. Text values have to be
+ * followed by the '\0' sentinel (p_data[length]). The memory is not owned by
+ * the buffer, so inbuff_free() mustn't be used on it.
+ */
+void inbuff_mem(TS_Inbuffer *p_inbuff, const char *p_data, size_t length,
+                TE_Format format)
+{
+  p_inbuff->fd = -1;
+  p_inbuff->size = length;
+  p_inbuff->used = length;
+  p_inbuff->pos = 0;
+  p_inbuff->eof = true;               /* Nothing more to read. */
+  p_inbuff->mapped = false;
+  p_inbuff->format = format;
+  p_inbuff->p_data = (char *) p_data;
+
+  return;
+}
+
+
+/**
+ * Takes next part of the input of at least size characters (unless the end of
+ * input was reached), which ends at the boundary of values - at white space
+ * for text or at the multiple of BIN_VALUE_SIZE for binary values, except the
+ * incomplete end of input. Text part never ends by a string, which is wholly
+ * consumed upon matching failure, because its' skipping by bskipstr() skips
+ * the following string too - the part is extended by that string then.
+ * Returns address of the part in the buffer, which is valid until next
+ * reading from the buffer, and stores its' length into p_length. Returns NULL
+ * upon end of input or reading error (errno is set by read() then).
+ */
+const char *inbuff_take(TS_Inbuffer *p_inbuff, size_t size,
+                        size_t *p_length)
+{
+  while (p_inbuff->used - p_inbuff->pos < size) {
+    if (inbuff_more(p_inbuff) == 0)
+      break;
+  }
+
+  size_t rest = p_inbuff->used - p_inbuff->pos;   /* Available characters. */
+
+  if (rest == 0)
+    return NULL;
+
+  size_t length = (rest < size) ? rest : size;    /* Length of the part. */
+
+  if (p_inbuff->format == FORMAT_F64) {
+    if (length < rest || p_inbuff->eof == false)
+      length -= length % BIN_VALUE_SIZE;
+  }
+  else {
+    /* Last string of the part is completed, it can continue in the stream. */
+    length = inbuff_span(p_inbuff, length, false);
+
+    /* Parts are read separately, so the skipping mustn't cross them. */
+    while (inbuff_skips_next(p_inbuff, length) == true) {
+      size_t extended = inbuff_span(p_inbuff, length, true);
+
+      if (extended == length)
+        break;                        /* Nothing more to skip. */
+
+      length = extended;
+    }
+  }
+
+  const char *p_part = p_inbuff->p_data + p_inbuff->pos;
+
+  p_inbuff->pos += length;
+  *p_length = length;
+
+  return p_part;
+}
+
+
+/**
+ * Dispose of the input buffer. The stream is not closed.
+ */
+void inbuff_free(TS_Inbuffer *p_inbuff)
+{
+  if (p_inbuff->mapped == true)
+    munmap((void *) p_inbuff->p_data, p_inbuff->size);
+  else
+    free((void *) p_inbuff->p_data);
+
+  p_inbuff->mapped = false;
+
+  /* Values reseting for safety reasons. */
+  p_inbuff->size = 0;
+  p_inbuff->used = 0;
+  p_inbuff->pos = 0;
+  p_inbuff->p_data = NULL;
+
+  return;
+}
+
+
+/**
+ * Initialization of the output buffer for given stream, values are written in
+ * given format. Returns EXIT_FAILURE and sets errno to ENOMEM, if the memory
+ * allocation has failed. Text output into terminal is flushed after every
+ * line. Buffer with no stream (NULL) is extended instead of flushing, so it
+ * can hold any number of values.
+ */
+int outbuff_init(TS_Outbuffer *p_outbuff, FILE *f_stream, TE_Format format)
+{
+  /* Buffer values initialization. */
+  p_outbuff->f_stream = f_stream;
+  p_outbuff->size = 0;
+  p_outbuff->used = 0;
+  p_outbuff->line = (f_stream != NULL && isatty(fileno(f_stream)));
+  p_outbuff->format = format;
+
+  /* Buffer memory allocation. */
+  p_outbuff->p_data = (char *) malloc(BUFF_SIZE_DEF * sizeof(char));
+
+  if (p_outbuff->p_data == NULL) {  /* Memory allocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->size = BUFF_SIZE_DEF;  /* New size of buffer. */
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Writes the content of the output buffer into its' stream. Returns
+ * EXIT_FAILURE upon writing error, errno is set by fwrite() then.
+ */
+int outbuff_flush(TS_Outbuffer *p_outbuff)
+{
+  size_t written = fwrite(p_outbuff->p_data, sizeof(char), p_outbuff->used,
+                          p_outbuff->f_stream);
+
+  if (written != p_outbuff->used) {
+    p_outbuff->used = 0;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->used = 0;
+
+  /* The stream itself is flushed too, so the output is in its' place. */
+  return (fflush(p_outbuff->f_stream) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/**
+ * Writes n characters into the output buffer. Block larger than the buffer is
+ * written into its' stream directly, after the content of the buffer. Returns
+ * EXIT_FAILURE upon writing error, errno is set by fwrite() then.
+ */
+int outbuff_write(TS_Outbuffer *p_outbuff, const char *p_src, size_t n)
+{
+  if (outbuff_reserve(p_outbuff, n) == EXIT_FAILURE)
+    return EXIT_FAILURE;
+
+  if (n > p_outbuff->size - p_outbuff->used) {
+    if (fwrite(p_src, sizeof(char), n, p_outbuff->f_stream) != n)
+      return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+  }
+
+  memcpy(p_outbuff->p_data + p_outbuff->used, p_src, n);
+  p_outbuff->used += n;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Dispose of the output buffer. The content of buffer is not flushed and the
+ * stream is not closed.
+ */
+void outbuff_free(TS_Outbuffer *p_outbuff)
+{
+  free((void *) p_outbuff->p_data);
+
+  /* Values reseting for safety reasons. */
+  p_outbuff->size = 0;
+  p_outbuff->used = 0;
+  p_outbuff->p_data = NULL;
+
+  return;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Reads another block of the stream into the input buffer. It keeps the
+ * unprocessed characters - they are moved to the beginning of the buffer
+ * first. If the whole buffer is unprocessed, it is extended to double of its'
+ * size. Returns number of new characters in buffer, zero upon end of stream or
+ * error. The errno is set by read() or to ENOMEM upon error.
+ */
+static size_t inbuff_more(TS_Inbuffer *p_inbuff)
+{
+  size_t rest = p_inbuff->used - p_inbuff->pos;   /* Unprocessed characters. */
+  ssize_t got;                                    /* Read characters. */
+
+  if (p_inbuff->eof == true)
+    return 0;
+
+  if (p_inbuff->pos > 0) {
+    memmove(p_inbuff->p_data, p_inbuff->p_data + p_inbuff->pos, rest);
+    p_inbuff->pos = 0;
+    p_inbuff->used = rest;
+  }
+  else if (p_inbuff->used == p_inbuff->size) {
+
+    char *p_new = (char *) realloc((void *) p_inbuff->p_data,
+                                   (2 * p_inbuff->size + 1) * sizeof(char));
+
+    if (p_new == NULL) {          /* Memory reallocation failed? */
+      p_inbuff->eof = true;
+      errno = ENOMEM;
+      return 0;
+    }
+
+    p_inbuff->p_data = p_new;
+    p_inbuff->size *= 2;          /* New size of buffer. */
+  }
+
+  /* Terminal returns every line immediately, other streams whole blocks. */
+  do {
+    got = read(p_inbuff->fd, p_inbuff->p_data + p_inbuff->used,
+               p_inbuff->size - p_inbuff->used);
+  } while (got == -1 && errno == EINTR);
+
+  if (got <= 0) {
+    p_inbuff->eof = true;   /* End of stream or error, no more reading. */
+    got = 0;
+  }
+
+  p_inbuff->used += (size_t) got;
+  p_inbuff->p_data[p_inbuff->used] = '\0';
+
+  return (size_t) got;
+}
+
+
+/**
+ * Skips white spaces in the input buffer and makes sure, that the following
+ * string is whole in the buffer, so it can be parsed without any testing of
+ * the buffer end - it is followed by a white space or by the '\0' sentinel.
+ * Returns false, if there's nothing more to read.
+ */
+static bool inbuff_token(TS_Inbuffer *p_inbuff)
+{
+  /* Skipping of white spaces. */
+  while (true) {
+    while (p_inbuff->pos < p_inbuff->used
+           && is_space(p_inbuff->p_data[p_inbuff->pos]) == true) {
+      p_inbuff->pos++;
+    }
+
+    if (p_inbuff->pos < p_inbuff->used)
+      break;
+
+    if (inbuff_more(p_inbuff) == 0)
+      return false;
+  }
+
+  size_t length = 0;        /* Length of the string found so far. */
+
+  /* Searching for the end of the string. */
+  while (true) {
+    char *p_act = p_inbuff->p_data + p_inbuff->pos + length;
+
+    while (is_space(*p_act) == false && *p_act != '\0')
+      p_act++;
+
+    length = (size_t) (p_act - (p_inbuff->p_data + p_inbuff->pos));
+
+    /* End of the string or of the whole input? */
+    if (p_inbuff->pos + length < p_inbuff->used || inbuff_more(p_inbuff) == 0)
+      break;
+  }
+
+  return true;
+}
+
+
+/**
+ * Makes sure there are at least n unprocessed bytes in the input buffer.
+ * Returns false upon end of input or reading error. Incomplete rest of input
+ * is consumed and errno is set to EINVAL then.
+ */
+static bool inbuff_bytes(TS_Inbuffer *p_inbuff, size_t n)
+{
+  while (p_inbuff->used - p_inbuff->pos < n) {
+    if (inbuff_more(p_inbuff) == 0)
+      break;
+  }
+
+  if (p_inbuff->used - p_inbuff->pos >= n)
+    return true;
+
+  if (p_inbuff->used > p_inbuff->pos) {
+    p_inbuff->pos = p_inbuff->used;
+    errno = EINVAL;
+  }
+
+  return false;
+}
+
+
+/**
+ * Extends the length of unprocessed characters in the input buffer to the end
+ * of the string, which continues there, or which follows the white spaces
+ * there, if space is true. Buffer is refilled when needed. Returns the new
+ * length, which is the end of input at most.
+ */
+static size_t inbuff_span(TS_Inbuffer *p_inbuff, size_t length, bool space)
+{
+  /* White spaces are skipped first (if required), then the string. */
+  for (int phase = (space == true) ? 0 : 1; phase < 2; phase++) {
+    bool white = (phase == 0);        /* Are white spaces skipped now? */
+
+    while (true) {
+      while (length < p_inbuff->used - p_inbuff->pos
+             && is_space(p_inbuff->p_data[p_inbuff->pos + length]) == white) {
+        length++;
+      }
+
+      if (length < p_inbuff->used - p_inbuff->pos || inbuff_more(p_inbuff) == 0)
+        break;
+    }
+  }
+
+  return length;
+}
+
+
+/**
+ * Tests, whether the last string within the first length unprocessed
+ * characters of the input buffer is consumed wholly upon matching failure of
+ * breadtod(), so bskipstr() would skip the following string (as by glibc's
+ * fscanf()). The string has to be followed by a white space or by the '\0'
+ * sentinel.
+ */
+static bool inbuff_skips_next(TS_Inbuffer *p_inbuff, size_t length)
+{
+  const char *p_part = p_inbuff->p_data + p_inbuff->pos;
+  size_t end = length;                /* End of the last string. */
+
+  while (end > 0 && is_space(p_part[end - 1]) == true)
+    end--;
+
+  size_t start = end;                 /* Beginning of the last string. */
+
+  while (start > 0 && is_space(p_part[start - 1]) == false)
+    start--;
+
+  if (start == end)
+    return false;                     /* No string at all. */
+
+  bool ok;                            /* Was the value read? */
+  double num;
+
+  const char *p_end = scan_double(p_part + start, &num, &ok);
+
+  return ok == false && (size_t) (p_end - p_part) >= end;
+}
+
+
+/**
+ * Makes sure there's space for at least n characters in the output buffer by
+ * flushing it, or by extending it, if the buffer has no stream. Returns
+ * EXIT_FAILURE and sets errno upon error.
+ */
+static int outbuff_reserve(TS_Outbuffer *p_outbuff, size_t n)
+{
+  if (p_outbuff->size - p_outbuff->used >= n)
+    return EXIT_SUCCESS;
+
+  if (p_outbuff->f_stream != NULL)
+    return outbuff_flush(p_outbuff);
+
+  size_t new_size = 2 * p_outbuff->size;    /* New size of buffer. */
+
+  if (new_size - p_outbuff->used < n)
+    new_size = p_outbuff->used + n;
+
+  char *p_new = (char *) realloc((void *) p_outbuff->p_data,
+                                 new_size * sizeof(char));
+
+  if (p_new == NULL) {            /* Memory reallocation failed? */
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  p_outbuff->p_data = p_new;
+  p_outbuff->size = new_size;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Compares beginning of the string with given lowercase word, regardless of
+ * the case. Returns address of the first character following the word. Upon
+ * mismatch the mismatching character is consumed too (as by glibc's fscanf())
+ * and false is stored into p_ok.
+ */
+static const char *scan_word(const char *p_act, const char *p_word,
+                             bool *p_ok)
+{
+  for (; *p_word != '\0'; p_word++, p_act++) {
+    if (to_lower(*p_act) != *p_word) {
+      *p_ok = false;
+      return (*p_act == '\0') ? p_act : p_act + 1;
+    }
+  }
+
+  *p_ok = true;
+  return p_act;
+}
+
+
+/**
+ * Parses double value from the beginning of the string, which doesn't start
+ * with a white space. Syntax is the same as of strtod(), the value is stored
+ * into p_num and the address of the first character following the consumed
+ * characters is returned. Upon matching failure, false is stored into p_ok.
+ *
+ * Decimal values with at most 19 significant digits, which are exactly
+ * representable together with their power of 10 (fast path of Clinger), are
+ * computed by one multiplication or division, which is correctly rounded. The
+ * rest of values (and hexadecimal ones) is converted by strtod().
+ */
+static const char *scan_double(const char *p_act, double *p_num, bool *p_ok)
+{
+  const char *p_start = p_act;        /* Beginning of the value. */
+
+  bool negative = false;              /* Is the value negative? */
+
+  if (*p_act == '+' || *p_act == '-') {
+    negative = (*p_act == '-');
+    p_act++;
+  }
+
+  /* Infinity ("inf" or "infinity") and NaN. */
+  if (to_lower(*p_act) == 'i') {
+    p_act = scan_word(p_act, "inf", p_ok);
+
+    if (*p_ok == true && to_lower(*p_act) == 'i')
+      p_act = scan_word(p_act, "inity", p_ok);
+
+    *p_num = (negative == true) ? -INFINITY : INFINITY;
+    return p_act;
+  }
+  else if (to_lower(*p_act) == 'n') {
+    p_act = scan_word(p_act, "nan", p_ok);
+    *p_num = (negative == true) ? -NAN : NAN;
+    return p_act;
+  }
+
+  /* Hexadecimal value. */
+  if (p_act[0] == '0' && to_lower(p_act[1]) == 'x') {
+    bool point = (p_act[2] == '.');   /* Decimal point after "0x"? */
+
+    /* No hexadecimal digit, "0x" is consumed upon matching failure. */
+    if (is_xdigit(p_act[2 + point]) == false) {
+      *p_num = (negative == true) ? -0.0 : 0.0;
+      *p_ok = point;
+      return p_act + 2 + point;
+    }
+
+    char *p_end;
+    *p_num = strtod(p_start, &p_end);
+    *p_ok = true;
+
+    /* Incomplete binary exponent, see the decimal exponent below. */
+    if (to_lower(*p_end) == 'p') {
+      p_end++;
+      p_end += (*p_end == '+' || *p_end == '-');
+    }
+
+    return p_end;
+  }
+
+  uint64_t mant = 0;                  /* Significant digits. */
+  int digits = 0;                     /* Number of significant digits. */
+  long exp10 = 0;                     /* Decimal exponent of mant. */
+
+  bool any = false;                   /* Was any digit read? */
+  bool exact = true;                  /* Is mant * 10^exp10 exact value? */
+
+  /* Digits before and after the decimal point. */
+  for (int frac = 0; frac < 2; frac++) {
+
+    for (; *p_act >= '0' && *p_act <= '9'; p_act++) {
+      int digit = *p_act - '0';
+
+      any = true;
+
+      if (digits < SAFE_DIGITS) {
+        mant = mant * 10 + (uint64_t) digit;
+        digits += (mant != 0);        /* Leading zeros aren't significant. */
+        exp10 -= frac;
+      }
+      else {
+        exp10 += 1 - frac;
+        exact = exact && digit == 0;
+      }
+    }
+
+    if (frac == 1 || *p_act != '.')
+      break;
+
+    p_act++;                          /* Skipping the decimal point. */
+  }
+
+  /* No digit - matching failure, mismatching character isn't consumed. */
+  if (any == false) {
+    *p_ok = false;
+    return p_act;
+  }
+
+  /* Exponent, incomplete one is consumed without an effect (as by fscanf). */
+  if (to_lower(*p_act) == 'e') {
+    bool exp_neg = false;             /* Is the exponent negative? */
+    long exp_val = 0;                 /* Value of the exponent. */
+
+    p_act++;
+
+    if (*p_act == '+' || *p_act == '-') {
+      exp_neg = (*p_act == '-');
+      p_act++;
+    }
+
+    for (; *p_act >= '0' && *p_act <= '9'; p_act++) {
+      if (exp_val < 100000)           /* Way out of range of double anyway. */
+        exp_val = exp_val * 10 + (*p_act - '0');
+    }
+
+    exp10 += (exp_neg == true) ? -exp_val : exp_val;
+  }
+
+  *p_ok = true;
+
+  /* Fast path, both values are exact, so the result is correctly rounded. */
+  if (mant == 0)
+    *p_num = 0.0;
+  else if (exact == true && mant <= EXACT_INT_MAX
+           && exp10 >= -EXACT_POW10_MAX && exp10 <= EXACT_POW10_MAX) {
+    *p_num = (exp10 < 0) ? (double) mant / exact_pow10[-exp10]
+                         : (double) mant * exact_pow10[exp10];
+  }
+  else {
+    *p_num = strtod(p_start, NULL);   /* Sets errno upon overflow too. */
+    return p_act;
+  }
+
+  if (negative == true)
+    *p_num = -*p_num;
+
+  return p_act;
+}
+
+
+/**
+ * Stores the value in the same format as sprintf(p_dest, "%.10e\n", num) does
+ * and returns number of stored characters. Digits of finite non-zero value
+ * are taken from value scaled into interval of 10^10 to 10^11 by pow10_scale().
+ * Values too close to the half between two possible results are printed by
+ * snprintf() instead, so the rounding is always the same.
+ */
+static size_t sprint_double(char *p_dest, double num)
+{
+  if (isfinite(num) == false || num == 0.0)
+    return (size_t) snprintf(p_dest, MAX_DOUBLE_STR, "%.10e\n", num);
+
+  int exp2;                                 /* Binary exponent of num. */
+
+  frexp(num, &exp2);
+
+  /* Estimation of the decimal exponent, it can be lower by one. */
+  int exp10 = (int) floor((exp2 - 1) * LOG10_2);
+
+  TS_Ddouble scaled;                        /* |num| * 10^(10 - exp10) */
+
+  const double lower = exact_pow10[PRINT_PREC];
+  const double upper = exact_pow10[PRINT_PREC + 1];
+
+  while (true) {
+    scaled = pow10_scale(fabs(num), PRINT_PREC - exp10);
+
+    if (scaled.hi < lower || (scaled.hi == lower && scaled.lo < 0.0))
+      exp10--;
+    else if (scaled.hi > upper || (scaled.hi == upper && scaled.lo >= 0.0))
+      exp10++;
+    else
+      break;
+  }
+
+  /* Integer and fractional part of the scaled value. */
+  double whole = floor(scaled.hi);
+  double frac = (scaled.hi - whole) + scaled.lo;
+
+  if (frac < 0.0) {
+    whole -= 1.0;
+    frac += 1.0;
+  }
+  else if (frac >= 1.0) {
+    whole += 1.0;
+    frac -= 1.0;
+  }
+
+  if (fabs(frac - 0.5) < ROUND_TIE_EPS)
+    return (size_t) snprintf(p_dest, MAX_DOUBLE_STR, "%.10e\n", num);
+
+  uint64_t value = (uint64_t) whole + (frac > 0.5);
+
+  /* Rounding up to 10^11. */
+  if (value == (uint64_t) upper) {
+    value /= 10;
+    exp10++;
+  }
+
+  char *p_act = p_dest;
+
+  if (signbit(num))
+    *p_act++ = '-';
+
+  /* Digits are stored from the last one. */
+  for (int i = PRINT_PREC + 1; i > 1; i--) {
+    p_act[i] = (char) ('0' + value % 10);
+    value /= 10;
+  }
+
+  p_act[0] = (char) ('0' + value);
+  p_act[1] = '.';
+  p_act += PRINT_PREC + 2;
+
+  *p_act++ = 'e';
+  *p_act++ = (exp10 < 0) ? '-' : '+';
+
+  exp10 = abs(exp10);
+
+  if (exp10 >= 100)
+    *p_act++ = (char) ('0' + exp10 / 100);
+
+  *p_act++ = (char) ('0' + exp10 / 10 % 10);
+  *p_act++ = (char) ('0' + exp10 % 10);
+  *p_act++ = '\n';
+
+  return (size_t) (p_act - p_dest);
+}
+
+
+/**
+ * Computes num * 10^exp10 as double-double value by multiplication with the
+ * double-double powers of 10^(2^i). The binary exponent is kept aside after
+ * every multiplication, so neither overflow nor underflow can occur. Relative
+ * error of the result is around 10^-30.
+ */
+static TS_Ddouble pow10_scale(double num, int exp10)
+{
+  const TS_Ddouble *p_table = (exp10 < 0) ? pow10_neg : pow10_pos;
+
+  int exp2;                                 /* Binary exponent kept aside. */
+  int shift;                                /* Exponent of one product. */
+
+  TS_Ddouble result = {frexp(num, &exp2), 0.0};
+
+  for (int i = 0, bits = abs(exp10); bits != 0; i++, bits >>= 1) {
+
+    if ((bits & 1) == 0)
+      continue;
+
+    result = dd_mul(result, p_table[i]);
+
+    result.hi = frexp(result.hi, &shift);
+    result.lo = ldexp(result.lo, -shift);
+    exp2 += shift;
+  }
+
+  result.hi = ldexp(result.hi, exp2);
+  result.lo = ldexp(result.lo, exp2);
+
+  return result;
+}
+
+
+/**
+ * Multiplication of double-double values. The exact product of leading parts
+ * is computed by Dekker's algorithm, so no FMA instruction is needed.
+ */
+static inline TS_Ddouble dd_mul(TS_Ddouble a, TS_Ddouble b)
+{
+  double prod = a.hi * b.hi;                /* Rounded product. */
+
+  /* Splitting of both leading parts into halves of 26 bits. */
+  double tmp = DEKKER_SPLIT * a.hi;
+  double a_hi = tmp - (tmp - a.hi);
+  double a_lo = a.hi - a_hi;
+
+  tmp = DEKKER_SPLIT * b.hi;
+  double b_hi = tmp - (tmp - b.hi);
+  double b_lo = b.hi - b_hi;
+
+  /* Rounding error of the product and the rest of parts. */
+  double err = ((a_hi * b_hi - prod) + a_hi * b_lo + a_lo * b_hi)
+               + a_lo * b_lo;
+
+  err += a.hi * b.lo + a.lo * b.hi;
+
+  TS_Ddouble result;
+
+  result.hi = prod + err;
+  result.lo = err - (result.hi - prod);
+
+  return result;
+}
+
+
+/**
+ * Conversion of 8 bytes of little-endian IEEE 754 double into the value, for
+ * any byte order of the machine.
+ */
+static inline double get_f64(const char *p_src)
+{
+  uint64_t bits = 0;                        /* Bits of the value. */
+  double num;
+
+  for (int i = BIN_VALUE_SIZE - 1; i >= 0; i--)
+    bits = (bits << 8) | (unsigned char) p_src[i];
+
+  memcpy(&num, &bits, sizeof(num));
+
+  return num;
+}
+
+
+/**
+ * Conversion of the value into 8 bytes of little-endian IEEE 754 double, for
+ * any byte order of the machine.
+ */
+static inline void put_f64(char *p_dest, double num)
+{
+  uint64_t bits;                            /* Bits of the value. */
+
+  memcpy(&bits, &num, sizeof(bits));
+
+  for (int i = 0; i < BIN_VALUE_SIZE; i++, bits >>= 8)
+    p_dest[i] = (char) (bits & 0xff);
+
+  return;
+}
+
+
+/**
+ * Test of byte order of the machine.
+ */
+static inline bool is_little_endian(void)
+{
+  const uint64_t one = 1;
+  unsigned char first;                      /* Lowest addressed byte. */
+
+  memcpy(&first, &one, 1);
+
+  return first == 1;
+}
+
+
+/**
+ * White space test same as isspace() of "C" locale.
+ */
+static inline bool is_space(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+
+/**
+ * Hexadecimal digit test same as isxdigit() of "C" locale.
+ */
+static inline bool is_xdigit(char c)
+{
+  c = to_lower(c);
+
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+}
+
+
+/**
+ * Conversion of uppercase ASCII letter to lowercase one.
+ */
+static inline char to_lower(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+}
+
+
+/******************************************************************************
+ ***[ END OF PROJ2_BUFIO.C ]***************************************************
+ ******************************************************************************/
@@ -0,0 +1,137 @@
+/**
+ * File:          proj2_bufio.h
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #2 - Iterative calculations
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This is header file for proj2_bufio.c file and contains
+ *                functional prototypes of functions for block reading and
+ *                writing of numbers (as text or as binary values) and
+ *                structures of input and output buffers used alongside them.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj2.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+/******************************************************************************
+ ***[ START OF PROJ2_BUFIO.H ]*************************************************
+ ******************************************************************************/
+
+/*
+ * Safety mechanism against multiple including of this header file.
+ */
+#ifndef PROJ2_BUFIO_H
+#define PROJ2_BUFIO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+
+/******************************************************************************
+ ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Size of one binary value (little-endian IEEE 754 double). */
+#define BIN_VALUE_SIZE 8
+
+
+/******************************************************************************
+ ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Enumerate of formats of values in the streams.
+ */
+typedef enum format {
+  FORMAT_TEXT,              /* Text, same as of fscanf() and "%.10e\n". */
+  FORMAT_F64,               /* Raw little-endian doubles. */
+} TE_Format;
+
+
+/*
+ * Structure containing informations about buffer for reading input stream in
+ * large blocks.
+ */
+typedef struct inbuffer {
+  int fd;                   /* Descriptor of the stream to read from. */
+
+  size_t size;              /* Size of the buffer (without '\0' sentinel). */
+  size_t used;              /* Number of valid characters in the buffer. */
+  size_t pos;               /* Position of next character to process. */
+
+  bool eof;                 /* Was the end of stream reached? */
+  bool mapped;              /* Is the buffer memory-mapped file? */
+
+  TE_Format format;         /* Format of values in the stream. */
+
+  char *p_data;             /* Memory of buffer, p_data[used] is '\0'. */
+} TS_Inbuffer;
+
+
+/*
+ * Structure containing informations about buffer for writing output stream in
+ * large blocks.
+ */
+typedef struct outbuffer {
+  FILE *f_stream;           /* Stream to write into, NULL for memory. */
+
+  size_t size;              /* Size of the buffer. */
+  size_t used;              /* Number of used characters from buffer. */
+
+  bool line;                /* Flush after every line (terminal output)? */
+
+  TE_Format format;         /* Format of values in the stream. */
+
+  char *p_data;             /* Pointer to memory of buffer. */
+} TS_Outbuffer;
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF GLOBAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+int inbuff_init(TS_Inbuffer *p_inbuff, FILE *f_stream, TE_Format format);
+int inbuff_map(TS_Inbuffer *p_inbuff);
+void inbuff_mem(TS_Inbuffer *p_inbuff, const char *p_data, size_t length,
+                TE_Format format);
+const char *inbuff_take(TS_Inbuffer *p_inbuff, size_t size,
+                        size_t *p_length);
+void inbuff_free(TS_Inbuffer *p_inbuff);
+
+int outbuff_init(TS_Outbuffer *p_outbuff, FILE *f_stream, TE_Format format);
+int outbuff_flush(TS_Outbuffer *p_outbuff);
+int outbuff_write(TS_Outbuffer *p_outbuff, const char *p_src, size_t n);
+void outbuff_free(TS_Outbuffer *p_outbuff);
+
+int breadval(TS_Inbuffer *p_inbuff, double *p_num);
+int breadpair(TS_Inbuffer *p_inbuff, double *p_x, double *p_y);
+size_t breadpoints(TS_Inbuffer *p_inbuff, double *p_x, double *p_y,
+                   int *p_err, bool *p_nan, size_t n, bool *p_eof);
+int bskipval(TS_Inbuffer *p_inbuff);
+int bwriteval(TS_Outbuffer *p_outbuff, double num);
+
+int breadtod(TS_Inbuffer *p_inbuff, double *p_num);
+int bskipstr(TS_Inbuffer *p_inbuff);
+int bprint_double(TS_Outbuffer *p_outbuff, double num);
+
+int breadf64(TS_Inbuffer *p_inbuff, double *p_num);
+size_t breadf64_block(TS_Inbuffer *p_inbuff, const double **pp_values,
+                      double *p_dest, size_t n);
+int bwritef64(TS_Outbuffer *p_outbuff, double num);
+
+#endif
+
+/******************************************************************************
+ ***[ END OF PROJ2_BUFIO.H ]***************************************************
+ ******************************************************************************/
@@ -64,6 +64,8 @@ static inline void x_overlap_func(TS_Loblwe *p_loblwe);
 static inline void y_overlap_func(TS_Loblwe *p_loblwe);
 static inline void xy_overlap_func(TS_Loblwe *p_loblwe);
 
+static inline void csum_add(TS_Csum *p_sum, double len);
+
 
 /******************************************************************************
  ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -86,7 +88,7 @@ void lbl(TS_Lobl *p_lobl)
   p_lobl->y_dist *= p_lobl->y_dist;
 
   /* Sum + square root of distances addition. */
-  p_lobl->sum += sqrroot(p_lobl->x_dist + p_lobl->y_dist);
+  p_lobl->sum += sqrroot_p(p_lobl->x_dist + p_lobl->y_dist, DEFAULT_SIGDIG);
 
   /* Backup of current coordinates, which can be used in next computation. */
   p_lobl->x_bef = p_lobl->x_act;
@@ -115,6 +117,125 @@ void lbl(TS_Lobl *p_lobl)
 }
 
 
+/**
+ * Batch version of lbl(). Function adds n following points given by p_x and
+ * p_y fields to the broken line. Lengths of all n segments are computed at
+ * once by sqrroot_batch() and the sum after each point is stored into p_sum.
+ * Errno value of each point (same as lbl() would set) is stored into p_err.
+ */
+void lbl_batch(TS_Lobl *p_lobl, const double *p_x, const double *p_y,
+               double *p_sum, int *p_err, size_t n)
+{
+  /* Lengths of all segments, p_sum is used as a helpful field. */
+  lbl_segments(p_lobl, p_x, p_y, p_sum, p_err, n);
+
+  for (size_t i = 0; i < n; i++) {
+    p_lobl->sum += p_sum[i];
+    p_err[i] = 0;
+
+    /* Same handling of the sum as in lbl(). */
+    switch (fpclassify(p_lobl->sum)) {
+      case FP_NAN :
+        p_err[i] = EDOM;
+        p_lobl->sum = abs_d(p_lobl->sum);
+        break;
+
+      case FP_INFINITE :
+        p_err[i] = ERANGE;
+        break;
+
+      default :
+        break;
+    }
+
+    p_sum[i] = p_lobl->sum;
+  }
+
+  p_lobl->x_act = p_lobl->x_bef;
+  p_lobl->y_act = p_lobl->y_bef;
+
+  return;
+}
+
+
+/**
+ * Computes lengths of n segments of broken line ending in points given by p_x
+ * and p_y fields into p_len, the first one starts in the predecessor stored in
+ * p_lobl. The last point is stored as the predecessor afterwards. Lengths are
+ * computed at once by sqrroot_batch(), which stores its' errno values into
+ * p_err. The sum in p_lobl is not changed.
+ */
+void lbl_segments(TS_Lobl *p_lobl, const double *p_x, const double *p_y,
+                  double *p_len, int *p_err, size_t n)
+{
+  /* Powers of segment distances. */
+  for (size_t i = 0; i < n; i++) {
+    p_lobl->x_dist = p_x[i] - p_lobl->x_bef;
+    p_lobl->y_dist = p_y[i] - p_lobl->y_bef;
+
+    p_len[i] = p_lobl->x_dist * p_lobl->x_dist
+               + p_lobl->y_dist * p_lobl->y_dist;
+
+    p_lobl->x_bef = p_x[i];
+    p_lobl->y_bef = p_y[i];
+  }
+
+  sqrroot_batch(p_len, p_len, p_err, n, DEFAULT_SIGDIG);
+
+  return;
+}
+
+
+/**
+ * Adds n lengths of segments given by p_len field to the compensated sum.
+ * Sums of separate parts of broken line can be joined this way by adding hi
+ * and lo of one sum to the other one.
+ */
+void lbl_total(TS_Csum *p_sum, const double *p_len, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    csum_add(p_sum, p_len[i]);
+
+  return;
+}
+
+
+/**
+ * Same as lbl_batch(), but the lengths of segments are already computed and
+ * they are added to the compensated sum instead, so the result doesn't depend
+ * on the way, how the broken line was split into parts for lbl_total(). Sum
+ * after each segment is stored into p_res (which can be p_len) and errno value
+ * of the sum (same as lbl() would set) into p_err.
+ */
+void lbl_scan(TS_Csum *p_sum, const double *p_len, double *p_res, int *p_err,
+              size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    csum_add(p_sum, p_len[i]);
+    p_err[i] = 0;
+
+    /* Same handling of the sum as in lbl(). */
+    switch (fpclassify(p_sum->hi)) {
+      case FP_NAN :
+        p_err[i] = EDOM;
+        p_sum->hi = abs_d(p_sum->hi);
+        break;
+
+      case FP_INFINITE :
+        p_err[i] = ERANGE;
+        break;
+
+      default :
+        break;
+    }
+
+    p_res[i] = p_sum->hi;
+  }
+
+  return;
+}
+
+
 /**
  * Function computes new size of a broken line with absolute error value by
  * computing new minimal and maximal length of between 2 points and adding it
@@ -262,7 +383,8 @@ static inline void no_overlap_func(TS_Loblwe *p_loblwe)
   p_loblwe->y_dist *= p_loblwe->y_dist;
 
   /* Sum + square root of distances addition. */
-  p_loblwe->sum_min += sqrroot(p_loblwe->x_dist + p_loblwe->y_dist);
+  p_loblwe->sum_min += sqrroot_p(p_loblwe->x_dist + p_loblwe->y_dist,
+                                 DEFAULT_SIGDIG);
 
   
   /*
@@ -287,7 +409,8 @@ static inline void no_overlap_func(TS_Loblwe *p_loblwe)
   p_loblwe->y_dist *= p_loblwe->y_dist;
 
   /* Sum + square root of distances addition. */
-  p_loblwe->sum_max += sqrroot(p_loblwe->x_dist + p_loblwe->y_dist);
+  p_loblwe->sum_max += sqrroot_p(p_loblwe->x_dist + p_loblwe->y_dist,
+                                 DEFAULT_SIGDIG);
 
   return;
 }
@@ -321,7 +444,8 @@ static inline void x_overlap_func(TS_Loblwe *p_loblwe)
   p_loblwe->y_dist *= p_loblwe->y_dist;
 
   /* Power of axis distances. */
-  p_loblwe->sum_max += sqrroot(p_loblwe->x_dist + p_loblwe->y_dist);
+  p_loblwe->sum_max += sqrroot_p(p_loblwe->x_dist + p_loblwe->y_dist,
+                                 DEFAULT_SIGDIG);
 
   return;
 }
@@ -356,7 +480,8 @@ static inline void y_overlap_func(TS_Loblwe *p_loblwe)
   p_loblwe->y_dist *= p_loblwe->y_dist;
 
   /* Power of axis distances. */
-  p_loblwe->sum_max += sqrroot(p_loblwe->x_dist + p_loblwe->y_dist);
+  p_loblwe->sum_max += sqrroot_p(p_loblwe->x_dist + p_loblwe->y_dist,
+                                 DEFAULT_SIGDIG);
 
   return;
 }
@@ -385,7 +510,36 @@ static inline void xy_overlap_func(TS_Loblwe *p_loblwe)
   p_loblwe->y_dist *= p_loblwe->y_dist;
 
   /* Power of axis distances. */
-  p_loblwe->sum_max += sqrroot(p_loblwe->x_dist + p_loblwe->y_dist);
+  p_loblwe->sum_max += sqrroot_p(p_loblwe->x_dist + p_loblwe->y_dist,
+                                 DEFAULT_SIGDIG);
+
+  return;
+}
+
+
+/**
+ * Adds the length to the compensated sum. Rounding error of the addition is
+ * computed exactly by TwoSum algorithm of Knuth and it's accumulated in lo.
+ * Infinite and NaN sums are kept in hi only, same as by plain addition.
+ */
+static inline void csum_add(TS_Csum *p_sum, double len)
+{
+  double sum = p_sum->hi + len;
+
+  if (isfinite(sum) == false) {
+    p_sum->hi = sum;
+    p_sum->lo = 0.0;
+    return;
+  }
+
+  double len_part = sum - p_sum->hi;      /* Part of len added to hi. */
+  double err = (p_sum->hi - (sum - len_part)) + (len - len_part);
+
+  err += p_sum->lo;
+
+  /* Normalization, so hi is the rounded value of the whole sum. */
+  p_sum->hi = sum + err;
+  p_sum->lo = (isfinite(p_sum->hi)) ? err - (p_sum->hi - sum) : 0.0;
 
   return;
 }
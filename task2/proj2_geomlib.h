@@ -32,6 +32,9 @@
 #ifndef PROJ2_GEOMLIB_H
 #define PROJ2_GEOMLIB_H
 
+/* Size_t is used by batch versions of functions. */
+#include <stddef.h>
+
 /******************************************************************************
  ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
@@ -53,6 +56,16 @@ typedef struct lobl {
 } TS_Lobl;
 
 
+/**
+ * Compensated sum of lengths of broken line (hi + lo), used by lbl_total() and
+ * lbl_scan() functions.
+ */
+typedef struct csum {
+  double hi;                /* Rounded value of the sum. */
+  double lo;                /* Rounding error of hi. */
+} TS_Csum;
+
+
 /**
  * Contains values used for computing length of broken line with error in lble()
  * function.
@@ -86,6 +99,13 @@ typedef struct loblwe {
  ******************************************************************************/
 
 void lbl(TS_Lobl *p_lobl);
+void lbl_batch(TS_Lobl *p_lobl, const double *p_x, const double *p_y,
+               double *p_sum, int *p_err, size_t n);
+void lbl_segments(TS_Lobl *p_lobl, const double *p_x, const double *p_y,
+                  double *p_len, int *p_err, size_t n);
+void lbl_total(TS_Csum *p_sum, const double *p_len, size_t n);
+void lbl_scan(TS_Csum *p_sum, const double *p_len, double *p_res, int *p_err,
+              size_t n);
 void lble(TS_Loblwe *p_loblwe);
 
 #endif
@@ -38,12 +38,25 @@
 #include <errno.h>
 #include <fenv.h>
 #include <float.h>
+#include <limits.h>
 #include <math.h>
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "proj2_mathlib.h"
 
+/*
+ * AVX2 and AVX-512 versions of the batch evaluation of Maclaurin series are
+ * compiled only for x86 processors with GCC compatible compiler, which
+ * supports function specific targets. The use of them is decided at run time.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define MATHLIB_SIMD
+  #include <immintrin.h>
+#endif
+
 /******************************************************************************
  ~~~[ MACRO DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
@@ -72,15 +85,350 @@
   va_end(ap)                          /* End of work with stack. */
 
 
+/*
+ * Number of parts of ln(2) used by expn_heurstc() and size of exp2_table
+ * below.
+ */
+#define EXP_TABLE_SIZE 32
+
+
+/*
+ * Number of centers of the mantissa interval used by ln_heurstc() and size of
+ * ln_recip_table and ln_center_table below.
+ */
+#define LN_TABLE_SIZE 32
+
+
+/*
+ * Maximal number of terms of polynomial kernels, see poly_eval().
+ */
+#define POLY_TERMS_MAX 9
+
+
+/*
+ * Number of 32 bit words of 2 / PI in two_over_pi below, which is enough for
+ * the exponent of the biggest double value, and number of these words used
+ * by pi_half_rem() at once.
+ */
+#define TWO_OVER_PI_WORDS 36
+#define TWO_OVER_PI_WINDOW 6
+
+
+/*
+ * Number of values processed at once by the batch functions. Helpful fields of
+ * this size are kept on the stack.
+ */
+#define BATCH_CHUNK 256LU
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Value of EXP_TABLE_SIZE / ln(2). */
+static const double EXP_N_LN2_INV = 46.166241308446828;
+
+/*
+ * Value of ln(2) / EXP_TABLE_SIZE split into two parts. The high part has
+ * only 32 significant bits, so its' product with any integer lower than 2^21
+ * is exact.
+ */
+static const double LN2_N_HI = 0x1.62e42fee00000p-6;
+static const double LN2_N_LO = 0x1.a39ef35793c76p-38;
+
+/*
+ * Field of values 2^(j / EXP_TABLE_SIZE) for j from 0 to EXP_TABLE_SIZE - 1,
+ * see expn_heurstc().
+ */
+static const double exp2_table[EXP_TABLE_SIZE] = {
+  1,                     /* 2^(0/32) */
+  1.0218971486541166,    /* 2^(1/32) */
+  1.0442737824274138,    /* 2^(2/32) */
+  1.0671404006768237,    /* 2^(3/32) */
+  1.0905077326652577,    /* 2^(4/32) */
+  1.1143867425958924,    /* 2^(5/32) */
+  1.1387886347566916,    /* 2^(6/32) */
+  1.1637248587775775,    /* 2^(7/32) */
+  1.189207115002721,     /* 2^(8/32) */
+  1.215247359980469,     /* 2^(9/32) */
+  1.241857812073484,     /* 2^(10/32) */
+  1.2690509571917332,    /* 2^(11/32) */
+  1.2968395546510096,    /* 2^(12/32) */
+  1.3252366431597413,    /* 2^(13/32) */
+  1.3542555469368927,    /* 2^(14/32) */
+  1.383909881963832,     /* 2^(15/32) */
+  1.4142135623730951,    /* 2^(16/32) */
+  1.4451808069770467,    /* 2^(17/32) */
+  1.4768261459394993,    /* 2^(18/32) */
+  1.5091644275934228,    /* 2^(19/32) */
+  1.5422108254079407,    /* 2^(20/32) */
+  1.5759808451078865,    /* 2^(21/32) */
+  1.6104903319492543,    /* 2^(22/32) */
+  1.6457554781539649,    /* 2^(23/32) */
+  1.681792830507429,     /* 2^(24/32) */
+  1.7186192981224779,    /* 2^(25/32) */
+  1.7562521603732995,    /* 2^(26/32) */
+  1.7947090750031072,    /* 2^(27/32) */
+  1.8340080864093424,    /* 2^(28/32) */
+  1.8741676341103,       /* 2^(29/32) */
+  1.9152065613971474,    /* 2^(30/32) */
+  1.9571441241754002,    /* 2^(31/32) */
+};
+
+/* Value of 2 / PI. */
+static const double PI_HALF_INV = 0.63661977236758138;
+
+/*
+ * Value of PI / 2 split into three parts. The first two parts have only 33
+ * significant bits, so their products with any integer lower than 2^20 are
+ * exact, see co_sine_heurstc().
+ */
+static const double PI_HALF_1 = 0x1.921fb54400000p+0;
+static const double PI_HALF_2 = 0x1.0b4611a600000p-34;
+static const double PI_HALF_3 = 0x1.3198a2e037073p-69;
+
+/* Values bigger than this one are reduced by pi_half_rem(). */
+static const double PI_HALF_REM_LIMIT = 0x1.921fb54400000p+20;
+
+/*
+ * Binary expansion of 2 / PI in 32 bit words, starting with the most
+ * significant one, see pi_half_rem().
+ */
+static const uint32_t two_over_pi[TWO_OVER_PI_WORDS] = {
+  0xA2F9836E, 0x4E441529, 0xFC2757D1, 0xF534DDC0, 0xDB629599, 0x3C439041,
+  0xFE5163AB, 0xDEBBC561, 0xB7246E3A, 0x424DD2E0, 0x06492EEA, 0x09D1921C,
+  0xFE1DEB1C, 0xB129A73E, 0xE88235F5, 0x2EBB4484, 0xE99C7026, 0xB45F7E41,
+  0x3991D639, 0x835339F4, 0x9C845F8B, 0xBDF9283B, 0x1FF897FF, 0xDE05980F,
+  0xEF2F118B, 0x5A0A6D1F, 0x6D367ECF, 0x27CB09B7, 0x4F463F66, 0x9E5FEA2D,
+  0x7527BAC7, 0xEBE5F17B, 0x3D0739F7, 0x8A5292EA, 0x6BFB5FB1, 0x1F8D5D08,
+};
+
+/*
+ * Coefficients of polynomial kernels evaluated by poly_eval() for the values
+ * reduced by heuristics, i.e. Maclaurin series truncated to the fixed number
+ * of terms. The *_terms fields contain the number of used terms for sigdig
+ * from 1 to DBL_DIG. It is the lowest number, for which the first omitted term
+ * is lower than 0.5 * 10^-(sigdig + 1) of the result on whole reduced interval.
+ */
+
+/* e^r == P(r) for |r| <= ln(2) / (2 * EXP_TABLE_SIZE). */
+static const double exp_coef[POLY_TERMS_MAX] = {
+  1.0,                     /* 1 / 0! */
+  1.0,                     /* 1 / 1! */
+  0.5,                     /* 1 / 2! */
+  0.16666666666666666,     /* 1 / 3! */
+  0.041666666666666664,    /* 1 / 4! */
+  0.008333333333333333,    /* 1 / 5! */
+  0.001388888888888889,    /* 1 / 6! */
+};
+static const int exp_terms[DBL_DIG] = {
+  2, 2, 3, 3, 3, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7,
+};
+
+/* sin(r) == r * P(r^2) for |r| <= PI / 4. */
+static const double sin_coef[POLY_TERMS_MAX] = {
+  1.0,                     /* 1 / 1! */
+  -0.16666666666666666,    /* -1 / 3! */
+  0.008333333333333333,    /* 1 / 5! */
+  -0.0001984126984126984,  /* -1 / 7! */
+  2.7557319223985893e-06,  /* 1 / 9! */
+  -2.505210838544172e-08,  /* -1 / 11! */
+  1.6059043836821613e-10,  /* 1 / 13! */
+  -7.647163731819816e-13,  /* -1 / 15! */
+  2.8114572543455206e-15,  /* 1 / 17! */
+};
+static const int sin_terms[DBL_DIG] = {
+  2, 3, 4, 4, 4, 5, 5, 6, 6, 7, 7, 7, 8, 8, 9,
+};
+
+/* cos(r) == P(r^2) for |r| <= PI / 4. */
+static const double cos_coef[POLY_TERMS_MAX] = {
+  1.0,                     /* 1 / 0! */
+  -0.5,                    /* -1 / 2! */
+  0.041666666666666664,    /* 1 / 4! */
+  -0.001388888888888889,   /* -1 / 6! */
+  2.48015873015873e-05,    /* 1 / 8! */
+  -2.755731922398589e-07,  /* -1 / 10! */
+  2.08767569878681e-09,    /* 1 / 12! */
+  -1.1470745597729725e-11, /* -1 / 14! */
+  4.779477332387385e-14,   /* 1 / 16! */
+};
+static const int cos_terms[DBL_DIG] = {
+  3, 3, 4, 5, 5, 5, 6, 6, 7, 7, 8, 8, 8, 9, 9,
+};
+
+/* ln((1 + y) / (1 - y)) == 2 * y * P(y^2) for |y| <= 1 / 127, see ln(). */
+static const double ln_coef[POLY_TERMS_MAX] = {
+  1.0,                     /* 1 / 1 */
+  0.3333333333333333,      /* 1 / 3 */
+  0.2,                     /* 1 / 5 */
+  0.14285714285714285,     /* 1 / 7 */
+};
+static const int ln_terms[DBL_DIG] = {
+  1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 4, 4, 4,
+};
+
+/*
+ * Field of reciprocal values of centers 1 + j / LN_TABLE_SIZE for j from 0 to
+ * LN_TABLE_SIZE - 1, see ln_heurstc().
+ */
+static const double ln_recip_table[LN_TABLE_SIZE] = {
+  1,                     /* 1 / (1 + 0/32) */
+  0.96969696969696972,   /* 1 / (1 + 1/32) */
+  0.94117647058823528,   /* 1 / (1 + 2/32) */
+  0.91428571428571426,   /* 1 / (1 + 3/32) */
+  0.88888888888888884,   /* 1 / (1 + 4/32) */
+  0.86486486486486491,   /* 1 / (1 + 5/32) */
+  0.84210526315789469,   /* 1 / (1 + 6/32) */
+  0.82051282051282048,   /* 1 / (1 + 7/32) */
+  0.80000000000000004,   /* 1 / (1 + 8/32) */
+  0.78048780487804881,   /* 1 / (1 + 9/32) */
+  0.76190476190476186,   /* 1 / (1 + 10/32) */
+  0.7441860465116279,    /* 1 / (1 + 11/32) */
+  0.72727272727272729,   /* 1 / (1 + 12/32) */
+  0.71111111111111114,   /* 1 / (1 + 13/32) */
+  0.69565217391304346,   /* 1 / (1 + 14/32) */
+  0.68085106382978722,   /* 1 / (1 + 15/32) */
+  0.66666666666666663,   /* 1 / (1 + 16/32) */
+  0.65306122448979587,   /* 1 / (1 + 17/32) */
+  0.64000000000000001,   /* 1 / (1 + 18/32) */
+  0.62745098039215685,   /* 1 / (1 + 19/32) */
+  0.61538461538461542,   /* 1 / (1 + 20/32) */
+  0.60377358490566035,   /* 1 / (1 + 21/32) */
+  0.59259259259259256,   /* 1 / (1 + 22/32) */
+  0.58181818181818179,   /* 1 / (1 + 23/32) */
+  0.5714285714285714,    /* 1 / (1 + 24/32) */
+  0.56140350877192979,   /* 1 / (1 + 25/32) */
+  0.55172413793103448,   /* 1 / (1 + 26/32) */
+  0.5423728813559322,    /* 1 / (1 + 27/32) */
+  0.53333333333333333,   /* 1 / (1 + 28/32) */
+  0.52459016393442626,   /* 1 / (1 + 29/32) */
+  0.5161290322580645,    /* 1 / (1 + 30/32) */
+  0.50793650793650791,   /* 1 / (1 + 31/32) */
+};
+
+/*
+ * Field of natural logarithms of the centers above. Every value is computed
+ * from the rounded reciprocal value, so ln(x * ln_recip_table[j]) +
+ * ln_center_table[j] == ln(x) without any additional error.
+ */
+static const double ln_center_table[LN_TABLE_SIZE] = {
+  0,                     /* -ln(ln_recip_table[0]) */
+  0.03077165866675366,   /* -ln(ln_recip_table[1]) */
+  0.060624621816434854,  /* -ln(ln_recip_table[2]) */
+  0.089612158689687166,  /* -ln(ln_recip_table[3]) */
+  0.11778303565638351,   /* -ln(ln_recip_table[4]) */
+  0.14518200984449783,   /* -ln(ln_recip_table[5]) */
+  0.17185025692665928,   /* -ln(ln_recip_table[6]) */
+  0.19782574332991992,   /* -ln(ln_recip_table[7]) */
+  0.22314355131420971,   /* -ln(ln_recip_table[8]) */
+  0.24783616390458121,   /* -ln(ln_recip_table[9]) */
+  0.27193371548364181,   /* -ln(ln_recip_table[10]) */
+  0.2954642128938359,    /* -ln(ln_recip_table[11]) */
+  0.31845373111853459,   /* -ln(ln_recip_table[12]) */
+  0.34092658697059319,   /* -ln(ln_recip_table[13]) */
+  0.36290549368936847,   /* -ln(ln_recip_table[14]) */
+  0.38441169891033206,   /* -ln(ln_recip_table[15]) */
+  0.40546510810816444,   /* -ln(ln_recip_table[16]) */
+  0.42608439531090014,   /* -ln(ln_recip_table[17]) */
+  0.44628710262841947,   /* -ln(ln_recip_table[18]) */
+  0.46608972992459924,   /* -ln(ln_recip_table[19]) */
+  0.48550781578170077,   /* -ln(ln_recip_table[20]) */
+  0.50455601075239531,   /* -ln(ln_recip_table[21]) */
+  0.52324814376454787,   /* -ln(ln_recip_table[22]) */
+  0.54159728243274441,   /* -ln(ln_recip_table[23]) */
+  0.55961578793542277,   /* -ln(ln_recip_table[24]) */
+  0.57731536503482361,   /* -ln(ln_recip_table[25]) */
+  0.59470710774669278,   /* -ln(ln_recip_table[26]) */
+  0.61180154110599294,   /* -ln(ln_recip_table[27]) */
+  0.62860865942237421,   /* -ln(ln_recip_table[28]) */
+  0.6451379613735847,    /* -ln(ln_recip_table[29]) */
+  0.66139848224536502,   /* -ln(ln_recip_table[30]) */
+  0.67739882359180614,   /* -ln(ln_recip_table[31]) */
+};
+
+/*
+ * Coefficients of the linear approximation SQRT_SEED_0 + SQRT_SEED_1 * m of
+ * sqrt(m) for m from interval of 0.25 to 1.0, with the smallest possible
+ * relative error 1.5 * SQRT_SEED_1 - 1 (about 0.0295), see sqrt_heurstc().
+ */
+static const double SQRT_SEED_0 = 0.3431457505076198;
+static const double SQRT_SEED_1 = 0.6862915010152396;
+
+/*
+ * Number of Newton's steps of sqrroot() for each sigdig. Every step turns the
+ * relative error e of the approximation into e^2 / (2 * (1 + e)), so the error
+ * after 1, 2, 3 and 4 steps is below 4.5e-4, 1e-7, 5e-15 and 1.3e-29.
+ */
+static const int sqrt_steps[DBL_DIG] = {
+  1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 4, 4,
+};
+
+
+/******************************************************************************
+ ~~~[ LOCAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Contains values of one chunk of batch function, which require computation of
+ * Maclaurin series, see BATCH FUNCTIONS below.
+ */
+typedef struct batch {
+  size_t count;                       /* Number of collected values. */
+
+  size_t index[BATCH_CHUNK];          /* Positions of values in the batch. */
+  double x[BATCH_CHUNK];              /* Collected (modified) values. */
+  double y[BATCH_CHUNK];              /* Results of the computation. */
+  double aux[BATCH_CHUNK];            /* Helpful values of the computation. */
+  int err[BATCH_CHUNK];               /* Errno values of the computation. */
+} TS_Batch;
+
+
 /******************************************************************************
  ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
 
-static inline double expn_heurstc(double *p_x);
+static inline double expn_heurstc(double *p_x, int *p_exp);
 static inline double ln_heurstc(double *p_x);
-static inline void co_sine_heurstc(double *p_x);
+static inline int co_sine_heurstc(double *p_x);
+static inline double sqrt_heurstc(double *p_x, int *p_exp);
 
 static inline double mclrn_expan(double x, TS_Maclaur_series expan, int sigdig);
+static inline double mclrn_steps(double x, TS_Maclaur_series expan,
+                                 double eps_factor);
+static inline double mclrn_result(double sum, int *p_err);
+static inline double mclrn_status(double sum, int *p_err, int *p_except);
+
+static void mclrn_expan_batch(const double *p_x, double *p_sum, int *p_err,
+                              size_t n, TS_Maclaur_series expan, int sigdig,
+                              int *p_except);
+
+#ifdef MATHLIB_SIMD
+__attribute__((target("avx2")))
+static size_t mclrn_steps_avx2(const double *p_x, double *p_sum, size_t n,
+                               TS_Maclaur_series expan, double eps_factor);
+
+__attribute__((target("avx512f")))
+static size_t mclrn_steps_avx512(const double *p_x, double *p_sum, size_t n,
+                                 TS_Maclaur_series expan, double eps_factor);
+#endif
+
+static inline double poly_eval(double x, const double *p_coef, int terms);
+static void poly_eval_batch(const double *p_x, double *p_y, size_t n,
+                            const double *p_coef, int terms, bool square);
+
+static inline double co_sine_series(double x, int quadrant, int sigdig);
+static double pi_half_rem(double x, int *p_quadrant);
+static inline uint64_t bits_u64(const uint32_t *p_num, int pos);
+
+static inline double expn_result(double x, int *p_err);
+static inline double expn_status(double x, int *p_err, int *p_except);
+
+static inline void batch_add(TS_Batch *p_batch, size_t index, double x);
+static inline void batch_store(TS_Batch *p_batch, double *p_y, int *p_err);
+static inline void batch_feupdate(const fenv_t *p_env, int except);
+
+static inline int sigdig_check(int sigdig);
 
 
 /******************************************************************************
@@ -124,15 +472,14 @@ double xsciexp(double x, int y)
 
 
 /**
- * Computes value of exponential function (e^x where e is Euler's number) by 
- * double calling the mclrn_expan() function, first time over the even order
- * expansion and second time over the odd order expansion. (For better
- * understanding see Maclaurin expansion for exponential function.) Function
- * sets errno and raises FP exception upon error. One optional argument
- * representing number of required significant digits of the result can be used
- * (sigdig).
+ * Computes value of exponential function (e^x where e is Euler's number) by
+ * evaluating the polynomial kernel of Maclaurin expansion for the value reduced
+ * by expn_heurstc(). (For better understanding see Maclaurin expansion for
+ * exponential function.) Function sets errno and raises FP exception upon
+ * error. Argument sigdig represents number of required significant digits of
+ * the result.
  */
-double expn(double x, ...)
+double expn_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x value classification. */
 
@@ -158,9 +505,8 @@ double expn(double x, ...)
 
   
   /*
-   * Safety mechanism against too much long looping in expn_heurstc() for
-   * bigger values. The result of expn() will overflow/underflow for values
-   * outside of this interval.
+   * The result of expn() will overflow/underflow for values outside of this
+   * interval, so it's not computed at all.
    */
   if (x > 1000) {
     errno = ERANGE;
@@ -174,95 +520,32 @@ double expn(double x, ...)
   }
 
 
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of FP environment. */
 
-  double y = expn_heurstc(&x);    /* Heuristic for expn(x). */
-
-
-  /* Even order expansion initialization. */
-  TS_Maclaur_series expnt1 = {
-    .sum = 1.0,
-    .numer = 1.0,
-    .denom = 1.0,
-
-    .n = 0.0,
-
-    .oscillate = false,
-    .use_fact = true,
-  };
-
-  /* Odd order expansion initialization. */
-  TS_Maclaur_series expnt2 = {
-    .sum = x,
-    .numer = x,
-    .denom = 1.0,
-
-    .n = 1.0,
-
-    .oscillate = false,
-    .use_fact = true,
-  };
-
+  int exp2;                       /* Exponent of 2 from the heuristic. */
 
-  /* Parts of the result. */
-  expnt1.sum = mclrn_expan(x, expnt1, sigdig);
-  expnt2.sum = mclrn_expan(x, expnt2, sigdig);
+  double y = expn_heurstc(&x, &exp2);   /* Heuristic for expn(x). */
 
-  x = (expnt1.sum + expnt2.sum) * y;  /* Finalizing of the result. */
+  /* Finalizing of the result. */
+  x = ldexp(poly_eval(x, exp_coef, exp_terms[sigdig - 1]) * y, exp2);
 
   errno = 0;                          /* Reseting errno. */
   fesetenv(&env);                     /* Restoring FP environment. */
 
-
-  xcls = fpclassify(x);               /* Result classification. */
-
-  /*
-   * Detection of an error by return value of fpclassify(). Sets errno and
-   * raises exception correspondingly to the error, if there was any, and
-   * returns proper value as described in "man 7 math_error".
-   */
-  switch (xcls) {
-    /* Indeterminate form appeared. */
-    case FP_NAN :
-      errno = ERANGE;
-      feraiseexcept(FE_INVALID);
-      return x;
-
-    /* Overflow occurred. */
-    case FP_INFINITE :
-      errno = ERANGE;
-      feraiseexcept(FE_OVERFLOW);
-      return HUGE_VAL;
-
-    /* Underflow occurred. */
-    case FP_ZERO :
-    case FP_SUBNORMAL :
-      errno = ERANGE;
-      feraiseexcept(FE_UNDERFLOW);
-      return 0.0;
-
-    /* Zero and other results are correct. */
-    case FP_NORMAL :
-      return x;
-
-    /* Default only for warning disposal. This case should never occur! */
-    default :
-      return x;
-  }
+  return expn_result(x, &errno);      /* Result classification. */
 }
 
 
 /**
  * Computes value of natural logarithm by using transformed version of Maclaurin
- * series expansion. Function sets errno and raises FP exception upon error. One
- * optional argument representing number of required significant digits of the 
- * result can be used (sigdig).
+ * series expansion. Function sets errno and raises FP exception upon error.
+ * Argument sigdig represents number of required significant digits of the
+ * result.
  */
-double ln(double x, ...)
+double ln_p(double x, int sigdig)
 {
   /* Relation operations with NaN would fail. */
   if (isnan(x)) {
@@ -286,32 +569,18 @@ double ln(double x, ...)
   }
 
 
-  int sigdig;                   /* Variable for va_sigdig() macro below. */
-  
-  va_sigdig(x, sigdig);         /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
 
 
   double h = ln_heurstc(&x);    /* Heuristic for ln(x). */
 
   double y = (x - 1) / (x + 1); /* Transform. for quicker convergence rate. */
 
-  TS_Maclaur_series logarithm = {
-    .sum = y,
-    .numer = y,
-    .denom = 1.0,
-
-    .n = 1.0,
-
-    .oscillate = false,
-    .use_fact = false,
-  };
-
-  
-  logarithm.sum = mclrn_expan(y, logarithm, sigdig);
+  y *= poly_eval(y * y, ln_coef, ln_terms[sigdig - 1]);
 
-  logarithm.sum *= 2.0;         /* Correction because of used transform. */
+  y = mclrn_result(y, &errno) * 2.0;  /* Correction because of transform. */
 
-  return logarithm.sum + h;     /* Computed value + result of heuristic. */
+  return y + h;                 /* Computed value + result of heuristic. */
 }
 
 
@@ -320,10 +589,10 @@ double ln(double x, ...)
  * where the general logarithm is defined for base in interval of zero exclusive
  * to infinity exclusive, without 1.0. The value x has to be in interval of zero
  * inclusive to infinity inclusive. Function sets errno and raise FP exception
- * upon error. One optional argument representing number of required significant
- * digits of the result can be used (sigdig). 
+ * upon error. Argument sigdig represents number of required significant digits
+ * of the result.
  */
-double logax(double x, double base, ...)
+double logax_p(double x, double base, int sigdig)
 {
   /* 
    * Testing for correct base of logarithm. Testing of value x is performed in
@@ -336,23 +605,22 @@ double logax(double x, double base, ...)
     return NAN;
   }
 
-  int sigdig;                   /* Variable for va_sigdig() macro below. */
-
-  va_sigdig(base, sigdig);      /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
 
-  double numer = ln(x, sigdig);
-  double denom = ln(base, sigdig);
+  double numer = ln_p(x, sigdig);
+  double denom = ln_p(base, sigdig);
 
   return numer / denom;         /* Value of general logarithm. */
 }
 
 
 /**
- * Computes square root by using this identity: square root(x) = e^(ln(x)/2).
- * The value of x has to be in interval of 0 inclusive to infinity inclusive,
- * otherwise a domain error occurs. 
+ * Computes square root by Newton's method y = (y + x / y) / 2 for the mantissa
+ * of x, see sqrt_heurstc(). Number of steps is given by sigdig. The value of x
+ * has to be in interval of 0 inclusive to infinity inclusive, otherwise a
+ * domain error occurs.
  */
-double sqrroot(double x, ...)
+double sqrroot_p(double x, int sigdig)
 {
   /* Return for NaN, zero and infinite value. */
   if (isnan(x) || isinf(x) == 1 || fpclassify(x) == FP_ZERO) {
@@ -365,32 +633,26 @@ double sqrroot(double x, ...)
     return -NAN;
   }
 
+  sigdig = sigdig_check(sigdig);
 
-  int sigdig;                 /* Variable for va_sigdig() macro below. */
-  fenv_t env;                 /* FP environment storage. */
-
-  va_sigdig(x, sigdig);       /* Processes the optional sigdig argument. */
-  feholdexcept(&env);         /* Backup of current FP environment. */
+  int exp2;                           /* Exponent of 2 of the result. */
+  double y = sqrt_heurstc(&x, &exp2); /* Initial approximation. */
 
-  double result;
-  
-  result = ln(x, sigdig) / 2.0;     /* Intermediate step. */
-  result = expn(result, sigdig);    /* Final value. */
-  
-  errno = 0;                  /* Reseting errno. */
-  fesetenv(&env);             /* Restoring of FP environment. */
+  /* Newton's method for y^2 - x == 0. */
+  for (int i = 0; i < sqrt_steps[sigdig - 1]; i++)
+    y = 0.5 * (y + x / y);
 
-  return result;
+  return ldexp(y, exp2);
 }
 
 /**
- * Computes value of sine by calling mclrn_expan() with properly initialized
- * values. The result of function is in radians, if the given value is in
- * radians. (Same applies for degrees.) Function sets errno and raises FP
- * exception upon error. One optional argument representing number of required
- * significant digits of the result can be used (sigdig).
+ * Computes value of sine by evaluating the polynomial kernel for the value
+ * reduced by co_sine_heurstc(). The result of function is in radians, if the
+ * given value is in radians. (Same applies for degrees.) Function sets errno
+ * and raises FP exception upon error. Argument sigdig represents number of
+ * required significant digits of the result.
  */
-double sine(double x, ...)
+double sine_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x classification. */
 
@@ -415,33 +677,13 @@ double sine(double x, ...)
       break;
   }
 
-  co_sine_heurstc(&x);            /* Heuristic for sine & cosine. */
-
-  /* Underflow occured? */
-  if (fpclassify(x) == FP_ZERO) {
-    errno = ERANGE;
-    feraiseexcept(FE_UNDERFLOW);
-    return x;
-  }
-
-
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
-  
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
-  
-  TS_Maclaur_series sin_x = {
-    .sum = x,
-    .numer = x,
-    .denom = 1.0,
+  int quadrant = co_sine_heurstc(&x); /* Heuristic for sine & cosine. */
 
-    .n = 1.0,
 
-    .oscillate = true,
-    .use_fact = true,
-  };
+  sigdig = sigdig_check(sigdig);
 
   /* Return of final result. */
-  return mclrn_expan(x, sin_x, sigdig);
+  return co_sine_series(x, quadrant, sigdig);
 }
 
 
@@ -449,12 +691,11 @@ double sine(double x, ...)
  * Computes inverse sine of x (arcus sine) using special case of Maclaurin
  * expansion for values in interval -1.0 exclusive to 1.0 exclusive (without
  * factorial in denominator). Because of that the input value is transformed
- * into this interval and back after getting the result. Function computes
- * in radians. Also sets errno and raises FP exception upon error. One
- * optional argument representing the number of required significant digits
- * of the result can be used (sigdig).
+ * into this interval and back after getting the result. Function computes in
+ * radians. Also sets errno and raises FP exception upon error. Argument sigdig
+ * represents number of required significant digits of the result.
  */
-double arc_sine(double x, ...)
+double arc_sine_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);        /* x classification. */
 
@@ -488,17 +729,16 @@ double arc_sine(double x, ...)
     return (signbit(x)) ? -PI_HALF : PI_HALF;
 
 
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of current FP environment. */
 
   /*
    * Input value transformation for quicker and more accurate computation:
    * y = x / (1.0 + sqrt(1.0 - x^2))
    */
-  double y = x / (1.0 + sqrroot(1.0 - (x * x)));
+  double y = x / (1.0 + sqrroot_p(1.0 - (x * x), DEFAULT_SIGDIG));
 
   TS_Maclaur_series arc_sin = {
     .sum = y,
@@ -522,13 +762,13 @@ double arc_sine(double x, ...)
 
 /**
  * Computes value of hyperbolical sine of given value using this relation:
- * sinh(x) = (e^(2*x) - 1)/(2*e^x) | With this representation function can 
+ * sinh(x) = (e^(2*x) - 1)/(2*e^x) | With this representation function can
  * computes to bigger values without overflowing than would be sooner while
  * using Maclaurin expansion for hyperbolical sine. Function sets errno and
- * raises FP exception upon error. One optional argument representing number
- * of required significant digits of the result can be used (sigdig).
+ * raises FP exception upon error. Argument sigdig represents number of required
+ * significant digits of the result.
  */
-double hyper_sine(double x, ...)
+double hyper_sine_p(double x, int sigdig)
 {
   /*
    * Relation operations with NaN would fail,
@@ -538,14 +778,13 @@ double hyper_sine(double x, ...)
     return x;
 
   
-  int sigdig;                 /* Variable for va_sigdig() macro below. */
   fenv_t env;                 /* FP environment storage. */
 
-  va_sigdig(x, sigdig);       /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);         /* Backup of current FP environment. */
 
-  double numer = expn(x * 2, sigdig) - 1;   /*  e^(2 * x) - 1  */
-  double denom = expn(x, sigdig) * 2;       /*  2 * e^(x)  */
+  double numer = expn_p(x * 2, sigdig) - 1;   /*  e^(2 * x) - 1  */
+  double denom = expn_p(x, sigdig) * 2;       /*  2 * e^(x)  */
 
   errno = 0;                  /* Reseting errno. */
   fesetenv(&env);             /* Restoring FP environment. */
@@ -565,7 +804,7 @@ double hyper_sine(double x, ...)
  * Same as sine function, but instead of computing sine this function computes
  * cosine of given value.
  */
-double cosine(double x, ...)
+double cosine_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x classification. */
 
@@ -589,33 +828,13 @@ double cosine(double x, ...)
       break;
   }
 
-  co_sine_heurstc(&x);            /* Heuristic for sine & cosine. */
-  
-  /* Underflow error? */
-  if (fpclassify(x) == FP_ZERO) {
-    errno = ERANGE;
-    feraiseexcept(FE_UNDERFLOW);
-    return x;
-  }
-
+  int quadrant = co_sine_heurstc(&x); /* Heuristic for sine & cosine. */
 
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
-
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
-
-  TS_Maclaur_series cos_x = {
-    .sum = 1.0,
-    .numer = 1.0,
-    .denom = 1.0,
 
-    .n = 0.0,
+  sigdig = sigdig_check(sigdig);
 
-    .oscillate = true,
-    .use_fact = true,
-  };
-  
-  /* Return of final result. */
-  return mclrn_expan(x, cos_x, sigdig);
+  /* Return of final result, cos(x) == sin(x + PI / 2). */
+  return co_sine_series(x, quadrant + 1, sigdig);
 }
 
 
@@ -623,7 +842,7 @@ double cosine(double x, ...)
  * Same function as arc_sine(), but instead of computing inverse sine this 
  * function computes inverse cosine of x (arcus cosine).
  */
-double arc_cosine(double x, ...)
+double arc_cosine_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x classification. */
 
@@ -660,17 +879,16 @@ double arc_cosine(double x, ...)
     return (signbit(x)) ? PI : 0.0;
 
    
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of current FP environment. */
   
   /*
    * Input value transformation for quicker and more accurate computation:
    * y = x / (1.0 + sqrt(1.0 - x^2))
    */
-  double y = x / (1.0 + sqrroot(1.0 - (x * x)));
+  double y = x / (1.0 + sqrroot_p(1.0 - (x * x), DEFAULT_SIGDIG));
 
   TS_Maclaur_series arc_cos = {
     .sum = y,
@@ -698,7 +916,7 @@ double arc_cosine(double x, ...)
  * function computes hyperbolic cosine of given value using similar relation:
  * cosh(x) = (e^(2*x) + 1)/(2*e^x)
  */
-double hyper_cosine(double x, ...)
+double hyper_cosine_p(double x, int sigdig)
 {
   /* Relation operations with NaN would fail. */
   if (isnan(x))
@@ -708,14 +926,13 @@ double hyper_cosine(double x, ...)
     return abs_d(x);
 
 
-  int sigdig;                 /* Variable for va_sigdig() macro below. */
   fenv_t env;                 /* FP environment storage. */
 
-  va_sigdig(x, sigdig);       /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);         /* Backup of current FP environment. */
 
-  double numer = expn(x * 2, sigdig) + 1;   /*  e^(2 * x) + 1  */
-  double denom = expn(x, sigdig) * 2;       /*  2 * e^(x)  */
+  double numer = expn_p(x * 2, sigdig) + 1;   /*  e^(2 * x) + 1  */
+  double denom = expn_p(x, sigdig) * 2;       /*  2 * e^(x)  */
   
   errno = 0;                  /* Reseting errno. */
   fesetenv(&env);             /* Restoring FP environment. */
@@ -732,15 +949,14 @@ double hyper_cosine(double x, ...)
 
 
 /**
- * Computes inverse tangent of x (arcus tangent) using special case of
- * Maclaurin expansion for values in interval -1.0 exclusive to 1.0 exclusive
- * (without factorial in denominator). Because of that the input value is
- * transformed into this interval and back after getting the result. Function
- * computes in radians. Also sets errno and raises FP exception upon error.
- * One optional argument representing the number of required significant digits
- * of the result can be used (sigdig).
+ * Computes inverse tangent of x (arcus tangent) using special case of Maclaurin
+ * expansion for values in interval -1.0 exclusive to 1.0 exclusive (without
+ * factorial in denominator). Because of that the input value is transformed
+ * into this interval and back after getting the result. Function computes in
+ * radians. Also sets errno and raises FP exception upon error. Argument sigdig
+ * represents number of required significant digits of the result.
  */
-double arc_tangent(double x, ...)
+double arc_tangent_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x classification. */
 
@@ -768,17 +984,16 @@ double arc_tangent(double x, ...)
     return (signbit(x)) ? -PI_HALF : PI_HALF;
 
 
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of current FP environment. */
 
   /*
    * Input value transformation for quicker and more accurate computation:
    * y = x / (1.0 + sqrt(1.0 + x^2))
    */
-  double y = x / (1.0 + sqrroot(1.0 + (x * x)));
+  double y = x / (1.0 + sqrroot_p(1.0 + (x * x), DEFAULT_SIGDIG));
 
   TS_Maclaur_series arc_tan = {
     .sum = y,
@@ -802,11 +1017,11 @@ double arc_tangent(double x, ...)
 
 /**
  * Computes value of hyperbolical tangent of given value using this relation:
- * tanh(x) = (e^(2*x) - 1) / (e^(2*x) + 1) | Function sets errno and raises
- * FP exception upon error. One optional argument representing number of
- * required significant digits of the result can be used (sigdig).
+ * tanh(x) = (e^(2*x) - 1) / (e^(2*x) + 1) | Function sets errno and raises FP
+ * exception upon error. Argument sigdig represents number of required
+ * significant digits of the result.
  */
-double hyper_tangent(double x, ...)
+double hyper_tangent_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);     /* x value classification. */
 
@@ -827,13 +1042,12 @@ double hyper_tangent(double x, ...)
   }
 
   
-  int sigdig;                   /* Variable for va_sigdig() macro below. */
   fenv_t env;                   /* FP environment storage. */
 
-  va_sigdig(x, sigdig);         /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);           /* Backup of current FP environment. */
 
-  double step = expn(x * 2, sigdig);      /*  e^(2 * x)  */
+  double step = expn_p(x * 2, sigdig);      /*  e^(2 * x)  */
 
   errno = 0;                    /* Reseting errno. */
   fesetenv(&env);               /* Restoring FP environment. */
@@ -853,7 +1067,7 @@ double hyper_tangent(double x, ...)
  * relations, because of relation that acot(x) equals to atan() of inverse x.
  * However, inverse cotangent has different domain and image.
  */
-double arc_cotangent(double x, ...)
+double arc_cotangent_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x classification. */
 
@@ -884,10 +1098,9 @@ double arc_cotangent(double x, ...)
     return (signbit(x)) ? -PI_HALF : PI_HALF;
 
   
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of current FP environment. */
 
   x = 1.0 / x;                    /* acot(x) == atan(x^-1) */
@@ -896,7 +1109,7 @@ double arc_cotangent(double x, ...)
    * Input value transformation for quicker and more accurate computation:
    * y = x / (1.0 + sqrt(1.0 + x^2))
    */
-  double y = x / (1.0 + sqrroot(1.0 + (x * x)));
+  double y = x / (1.0 + sqrroot_p(1.0 + (x * x), DEFAULT_SIGDIG));
 
   TS_Maclaur_series arc_cot = {
     .sum = y,
@@ -923,7 +1136,7 @@ double arc_cotangent(double x, ...)
  * tangent this function computes hyperbolic cotangent of given value using
  * similar relation: coth(x) = (e^(2*x) + 1) / (e^(2*x) + 1)
  */
-double hyper_cotangent(double x, ...)
+double hyper_cotangent_p(double x, int sigdig)
 {
   int xcls = fpclassify(x);       /* x value classification. */
 
@@ -948,13 +1161,12 @@ double hyper_cotangent(double x, ...)
   }
 
 
-  int sigdig;                     /* Variable for va_sigdig() macro below. */
   fenv_t env;                     /* FP environment storage. */
 
-  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+  sigdig = sigdig_check(sigdig);
   feholdexcept(&env);             /* Backup of current FP environment. */
 
-  double step = expn(x * 2, sigdig);      /*  e^(2 * x)  */
+  double step = expn_p(x * 2, sigdig);      /*  e^(2 * x)  */
 
   errno = 0;                      /* Reseting errno. */
   fesetenv(&env);                 /* Restoring FP environment. */
@@ -969,150 +1181,1179 @@ double hyper_cotangent(double x, ...)
 
 
 /******************************************************************************
- ~~~[ HEURISTIC FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ~~~[ VARIADIC FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
 
+/*
+ * Variadic versions of primary functions above. One optional argument
+ * representing number of required significant digits of the result can be
+ * used (sigdig), which is decoded by va_sigdig() macro.
+ */
 /**
- * Heuristic for the exponential function (e^x). This function modifies the
- * input value towards 0.0 using relation of: exp(x+y) = exp(x) * exp(y) for
- * gaining the best rate of convergence. Function modifies the input value into
- * the interval of -1.0 exclusive to 1.0 exclusive and returns value of e^y,
- * where y represents number of periods (value 1.0) subtracted from the input
- * value (e^0 = 1.0).
+ * Variadic version of expn_p().
  */
-static inline double expn_heurstc(double *p_x)
+double expn(double x, ...)
 {
-  double y = 1.0;           /* e^y initialization. */
-  double i = trunc(*p_x);   /* Number of periods, iteration counter. */
-
-  *p_x -= i;                /* Lowering x value -> periods subtraction. */
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
 
-  /* Negative value? */
-  if (signbit(i))
-    /* e^y for y below zero. */
-    while (i <= -1.0) {
-      y *= EUL_NUM_INV;
-      i++;
-  }
-  else
-    /* e^y for y above zero. */
-    while (i >= 1.0) {
-      y *= EUL_NUM; 
-      i--;
-    }
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
 
-  return y;                 /* e^y to be multiplied with e^x later. */
+  return expn_p(x, sigdig);
 }
 
-
 /**
- * Heuristic for natural logarithm. This function modifies the input value of 
- * ln() by adjusting value towards 1.0 for gaining the best rate of convergence.
- * Return value represents the quantity of how many times the input value was
- * modified. Heuristic exploits this relation: ln(e) = 1, where e is the Euler's
- * number.
+ * Variadic version of ln_p().
  */
-static inline double ln_heurstc(double *p_x)
+double ln(double x, ...)
 {
-  double x_pred = 0;        /* Previous value of x. See the use below. */
-  double i = 0;             /* Modification counter. */
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
 
-  /*
-   * If input value is less than 1.0, then multiplying is required to get closer
-   * to 1.0, else the number is greater and dividing is required...
-   */
-  if (*p_x < 1.0) {
-    while (*p_x < 1.0) {
-      x_pred = *p_x;        /* Backup of previous value of x. */
-      *p_x *= EUL_NUM;      /* Multiplying by Euler's number. */
-      i--;                  /* Decreasing for proper value when adding later. */
-    }
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
 
-    /* Determining which value is closer to 1.0. */
-    if (abs_d(1.0 - *p_x) > abs_d(1.0 - x_pred)) {
-      *p_x = x_pred;        /* Previous value was closer. */
-      i++;                  /* Count correcting. */
-    }
-  }
-  else {
-    while (*p_x > 1.0) {
-      x_pred = *p_x;        /* Backup of previous value of x. */
-      *p_x /= EUL_NUM;      /* Dividing by Euler's number. */
-      i++;                  /* Increasing for proper value when adding later. */
-    }
-    
-    /* Determining which value is closer to 1.0. */
-    if (abs_d(1.0 - *p_x) > abs_d(1.0 - x_pred)) {
-      *p_x = x_pred;        /* Previous value was closer. */
-      i--;                  /* Count correcting. */
-    }
-  }
-  
-  /*
-   * Value to be add to the outcome of natural logarithm of new x to get a
-   * proper result of unmodified x.
-   */
-  return i;
+  return ln_p(x, sigdig);
 }
 
-
 /**
- * Heuristic for sine & cosine functions. This functions shifts the value into
- * interval of zero inclusive to 2 * PI exclusive because of periodicity of
- * trigonometric functions. Sine and cosine functions convergence is the fastest
- * for this interval.
+ * Variadic version of logax_p().
  */
-static inline void co_sine_heurstc(double *p_x)
+double logax(double x, double base, ...)
 {
-  double k = trunc(*p_x / PI_2X);   /* Detection of number of periods. */
-  double periods = k * PI_2X;       /* Value of periods. */
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
 
-  *p_x -= periods;                  /* Subtracting of the periods. */
+  va_sigdig(base, sigdig);        /* Processes the optional sigdig argument. */
 
-  /* Negative value? (Not in interval of 0 inclusive to 2 * PI exclusive?) */
-  if (signbit(*p_x)) {
-    *p_x += PI_2X;                  /* Shift to positive value. */
-  }
+  return logax_p(x, base, sigdig);
+}
 
-  return;
+/**
+ * Variadic version of sqrroot_p().
+ */
+double sqrroot(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return sqrroot_p(x, sigdig);
 }
 
+/**
+ * Variadic version of sine_p().
+ */
+double sine(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
 
-/******************************************************************************
- ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
- ******************************************************************************/
+  return sine_p(x, sigdig);
+}
 
 /**
- * Computes value of Maclaurin series (special type of Taylor series where
- * a == 0) for the most elementary expansions. The exact expansion depends on
- * values in given TS_Maclaur_series structure. When true is used for the 
- * oscillate, then function computes with oscillating sign of every addition.
- * When true is used for use_fact, then function computes with factorial as a
- * denominator. Sigdig represents number of digits of result that are
- * significant.
+ * Variadic version of arc_sine_p().
  */
-static inline double mclrn_expan(double x, TS_Maclaur_series expan, int sigdig)
+double arc_sine(double x, ...)
 {
-  if (isnan(x))           /* Relation operations with NaN would fail. */
-    return x;
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
 
-  double sum_pred;        /* Sum of all values before. */
-  double eps_factor;      /* Value used to compute new epsilon. */
-  double x2;              /* Value representing +/-(x^2), see below. */
-  double eps;             /* Wanted accuracy (epsilon) of actual step. */
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
 
-  sum_pred = 0.0;                       /* No sum yet. */
-  eps_factor = xsciexp(1.0, -sigdig);   /* 1*10^(-sigdig) */
+  return arc_sine_p(x, sigdig);
+}
 
+/**
+ * Variadic version of hyper_sine_p().
+ */
+double hyper_sine(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
 
-  /*
-   * Preprocess the value x^2. The sign of x2 depends on if there was a
-   * requirement for an oscillation of the sign.
-   */
-  if (expan.oscillate == true)
-    x2 = -(x * x);        /* Expansion with sign oscillation of each step.*/
-  else
-    x2 = x * x;           /* Expansion without sign oscillation. */
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return hyper_sine_p(x, sigdig);
+}
+
+/**
+ * Variadic version of cosine_p().
+ */
+double cosine(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return cosine_p(x, sigdig);
+}
+
+/**
+ * Variadic version of arc_cosine_p().
+ */
+double arc_cosine(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return arc_cosine_p(x, sigdig);
+}
+
+/**
+ * Variadic version of hyper_cosine_p().
+ */
+double hyper_cosine(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return hyper_cosine_p(x, sigdig);
+}
+
+/**
+ * Variadic version of arc_tangent_p().
+ */
+double arc_tangent(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return arc_tangent_p(x, sigdig);
+}
+
+/**
+ * Variadic version of hyper_tangent_p().
+ */
+double hyper_tangent(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return hyper_tangent_p(x, sigdig);
+}
+
+/**
+ * Variadic version of arc_cotangent_p().
+ */
+double arc_cotangent(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return arc_cotangent_p(x, sigdig);
+}
+
+/**
+ * Variadic version of hyper_cotangent_p().
+ */
+double hyper_cotangent(double x, ...)
+{
+  int sigdig;                     /* Variable for va_sigdig() macro below. */
+
+  va_sigdig(x, sigdig);           /* Processes the optional sigdig argument. */
+
+  return hyper_cotangent_p(x, sigdig);
+}
+
+
+/******************************************************************************
+ ~~~[ BATCH FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Batch versions of primary functions compute n values from p_x into p_y with
+ * required significant digits (corrected same way as the sigdig argument of
+ * primary functions). The errno value of every computation is stored into
+ * p_err instead of errno (0 if there was no error). FP environment is saved
+ * only once per batch, the FP exceptions of single values are collected into
+ * p_except of inner *_batch_fe() functions and raised at once by
+ * batch_feupdate() at the end of batch. Results are same as results of primary
+ * functions. Values are processed in chunks of BATCH_CHUNK values: special
+ * values are resolved one by one, the rest is collected into TS_Batch
+ * structure and its' Maclaurin series are evaluated at once by
+ * mclrn_expan_batch().
+ */
+
+
+/**
+ * Same as expn_batch(), but FP exceptions are added into p_except, see BATCH
+ * FUNCTIONS above.
+ */
+static void expn_batch_fe(const double *p_x, double *p_y, int *p_err,
+                          size_t n, int sigdig, int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int exp2[BATCH_CHUNK];          /* Exponents of 2 from the heuristic. */
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      switch (fpclassify(x)) {
+
+        /* NaN */
+        case FP_NAN :
+          p_y[i] = x;
+          continue;
+
+        /* e^inf == inf, e^-inf == 0.0 */
+        case FP_INFINITE :
+          p_y[i] = (signbit(x)) ? 0.0 : x;
+          continue;
+
+        /* e^0 = 1.0 */
+        case FP_ZERO :
+          p_y[i] = 1.0;
+          continue;
+
+        default :
+          break;
+      }
+
+      /* The result will overflow/underflow, see expn(). */
+      if (x > 1000) {
+        p_err[i] = ERANGE;
+        *p_except |= FE_OVERFLOW;
+        p_y[i] = HUGE_VAL;
+      }
+      else if (x < -1000) {
+        p_err[i] = ERANGE;
+        *p_except |= FE_UNDERFLOW;
+        p_y[i] = 0.0;
+      }
+      else
+        batch_add(&batch, i, x);
+    }
+
+    for (size_t j = 0; j < batch.count; j++)
+      batch.aux[j] = expn_heurstc(&batch.x[j], &exp2[j]);
+
+    poly_eval_batch(batch.x, batch.y, batch.count, exp_coef,
+                    exp_terms[sigdig - 1], false);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      size_t i = batch.index[j];
+
+      p_y[i] = expn_status(ldexp(batch.y[j] * batch.aux[j], exp2[j]),
+                           &p_err[i], p_except);
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of expn().
+ */
+void expn_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  expn_batch_fe(p_x, p_y, p_err, n, sigdig, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Same as ln_batch(), but FP exceptions are added into p_except, see BATCH
+ * FUNCTIONS above.
+ */
+static void ln_batch_fe(const double *p_x, double *p_y, int *p_err,
+                        size_t n, int sigdig, int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* Relation operations with NaN would fail. */
+      if (isnan(x)) {
+        p_y[i] = x;
+      }
+      /* Pole error - ln(0) is exact minus infinity. */
+      else if (fpclassify(x) == FP_ZERO) {
+        p_err[i] = ERANGE;
+        *p_except |= FE_DIVBYZERO;
+        p_y[i] = -HUGE_VAL;
+      }
+      /* Any negative values is out of any logarithm domain. */
+      else if (signbit(x)) {
+        p_err[i] = EDOM;
+        *p_except |= FE_INVALID;
+        p_y[i] = NAN;
+      }
+      /* Positive infinity of any logarithm is positive infinity. */
+      else if (isinf(x)) {
+        p_y[i] = HUGE_VAL;
+      }
+      else
+        batch_add(&batch, i, x);
+    }
+
+    for (size_t j = 0; j < batch.count; j++) {
+      batch.aux[j] = ln_heurstc(&batch.x[j]);
+      batch.x[j] = (batch.x[j] - 1) / (batch.x[j] + 1);
+    }
+
+    poly_eval_batch(batch.x, batch.y, batch.count, ln_coef,
+                    ln_terms[sigdig - 1], true);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      size_t i = batch.index[j];
+
+      p_err[i] = 0;
+      p_y[i] = mclrn_status(batch.y[j] * batch.x[j], &p_err[i], p_except)
+               * 2.0 + batch.aux[j];
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of ln().
+ */
+void ln_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+              int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  ln_batch_fe(p_x, p_y, p_err, n, sigdig, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Same as sqrroot_batch(), but FP exceptions are added into p_except, see BATCH
+ * FUNCTIONS above.
+ */
+static void sqrroot_batch_fe(const double *p_x, double *p_y, int *p_err,
+                             size_t n, int sigdig, int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int exp2[BATCH_CHUNK];          /* Exponents of 2 from the heuristic. */
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* Return for NaN, zero and positive infinity. */
+      if (isnan(x) || (isinf(x) && !signbit(x))
+          || fpclassify(x) == FP_ZERO) {
+        p_y[i] = x;
+      }
+      /* Negative value -> domain error. */
+      else if (signbit(x)) {
+        p_err[i] = EDOM;
+        *p_except |= FE_INVALID;
+        p_y[i] = -NAN;
+      }
+      else
+        batch_add(&batch, i, x);
+    }
+
+    for (size_t j = 0; j < batch.count; j++)
+      batch.y[j] = sqrt_heurstc(&batch.x[j], &exp2[j]);
+
+    /* Same Newton's steps as in sqrroot(), for all values at once. */
+    for (int s = 0; s < sqrt_steps[sigdig - 1]; s++) {
+      for (size_t j = 0; j < batch.count; j++)
+        batch.y[j] = 0.5 * (batch.y[j] + batch.x[j] / batch.y[j]);
+    }
+
+    for (size_t j = 0; j < batch.count; j++)
+      p_y[batch.index[j]] = ldexp(batch.y[j], exp2[j]);
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of sqrroot().
+ */
+void sqrroot_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                   int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  sqrroot_batch_fe(p_x, p_y, p_err, n, sigdig, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of sine() and cosine() (for true in cos).
+ */
+static void co_sine_batch(const double *p_x, double *p_y, int *p_err,
+                          size_t n, int sigdig, bool cos,
+                          int *p_except)
+{
+  TS_Batch batch[2];              /* Values for sine [0] & cosine [1] series. */
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch[0].count = batch[1].count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      switch (fpclassify(x)) {
+
+        /* Relation operations with NaN would fail. */
+        case FP_NAN :
+          p_y[i] = x;
+          continue;
+
+        /* Domain error. */
+        case FP_INFINITE :
+          p_err[i] = EDOM;
+          *p_except |= FE_INVALID;
+          p_y[i] = -NAN;
+          continue;
+
+        /* sin(0.0) == 0.0, cos(0.0) == 1.0 */
+        case FP_ZERO :
+          p_y[i] = (cos) ? 1.0 : x;
+          continue;
+
+        default :
+          break;
+      }
+
+      /* Heuristic for sine & cosine, see co_sine_series(). */
+      int quadrant = co_sine_heurstc(&x) + cos;
+      TS_Batch *p_batch = &batch[quadrant & 1];
+
+      batch_add(p_batch, i, x);
+      p_batch->aux[p_batch->count - 1] = (quadrant & 2) ? -1.0 : 1.0;
+    }
+
+    poly_eval_batch(batch[0].x, batch[0].y, batch[0].count, sin_coef,
+                    sin_terms[sigdig - 1], true);
+    poly_eval_batch(batch[1].x, batch[1].y, batch[1].count, cos_coef,
+                    cos_terms[sigdig - 1], true);
+
+    for (size_t j = 0; j < batch[0].count; j++)
+      batch[0].y[j] *= batch[0].x[j];
+
+    for (int b = 0; b < 2; b++) {
+      for (size_t j = 0; j < batch[b].count; j++) {
+        batch[b].err[j] = 0;
+        batch[b].y[j] = mclrn_status(batch[b].y[j], &batch[b].err[j],
+                                     p_except) * batch[b].aux[j];
+      }
+
+      batch_store(&batch[b], p_y, p_err);
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of sine().
+ */
+void sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  co_sine_batch(p_x, p_y, p_err, n, sigdig, false, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of cosine().
+ */
+void cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                  int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  co_sine_batch(p_x, p_y, p_err, n, sigdig, true, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_sine() and arc_cosine() (for true in cos).
+ */
+static void arc_co_sine_batch(const double *p_x, double *p_y, int *p_err,
+                              size_t n, int sigdig, bool cos,
+                              int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int inner = 0;                  /* Discarded inner FP exceptions. */
+
+  /* Expansion of inverse sine. Initial sums are set later. */
+  TS_Maclaur_series arc_sin = {
+    .sum = 0.0,
+    .numer = 0.0,
+    .denom = 1.0,
+
+    .n = 1.0,
+
+    .oscillate = true,
+    .use_fact = false,
+  };
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* Relation operations with NaN would fail. */
+      if (isnan(x)) {
+        p_y[i] = x;
+      }
+      /* asin(0.0) == 0.0, acos(0.0) == PI/2 */
+      else if (fpclassify(x) == FP_ZERO) {
+        p_y[i] = (cos) ? PI_HALF : x;
+      }
+      /* Domain error. (Infinity included.) */
+      else if (abs_d(x) > 1.0) {
+        p_err[i] = EDOM;
+        *p_except |= FE_INVALID;
+        p_y[i] = NAN;
+      }
+      /* asin(+-1.0) == +-PI/2, acos(-1.0) == PI, acos(1.0) == 0.0 */
+      else if (abs_d(x) == 1.0) {
+        if (cos)
+          p_y[i] = (signbit(x)) ? PI : 0.0;
+        else
+          p_y[i] = (signbit(x)) ? -PI_HALF : PI_HALF;
+      }
+      else
+        batch_add(&batch, i, x);
+    }
+
+    /*
+     * y = x / (1.0 + sqrt(1.0 - x^2)), the square root is computed with
+     * default sigdig same as in arc_sine().
+     */
+    for (size_t j = 0; j < batch.count; j++)
+      batch.aux[j] = 1.0 - (batch.x[j] * batch.x[j]);
+
+    sqrroot_batch_fe(batch.aux, batch.y, batch.err, batch.count,
+                     DEFAULT_SIGDIG, &inner);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      batch.y[j] = batch.x[j] / (1.0 + batch.y[j]);
+      batch.aux[j] = batch.y[j];
+    }
+
+    mclrn_expan_batch(batch.aux, batch.y, batch.err, batch.count, arc_sin,
+                      sigdig, &inner);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      if (cos)
+        p_y[batch.index[j]] = PI_HALF - (batch.y[j] * 2.0);
+      else
+        p_y[batch.index[j]] = batch.y[j] * 2.0;
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_sine().
+ */
+void arc_sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                    int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  arc_co_sine_batch(p_x, p_y, p_err, n, sigdig, false, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_cosine().
+ */
+void arc_cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                      int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  arc_co_sine_batch(p_x, p_y, p_err, n, sigdig, true, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_tangent() and arc_cotangent() (for true in cot).
+ */
+static void arc_co_tangent_batch(const double *p_x, double *p_y, int *p_err,
+                                 size_t n, int sigdig, bool cot)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int inner = 0;                  /* Discarded inner FP exceptions. */
+
+  /* Expansion of inverse tangent. Initial sums are set later. */
+  TS_Maclaur_series arc_tan = {
+    .sum = 0.0,
+    .numer = 0.0,
+    .denom = 1.0,
+
+    .n = 1.0,
+
+    .oscillate = true,
+    .use_fact = false,
+  };
+
+  sigdig = sigdig_check(sigdig);
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* Relation operations with NaN would fail. */
+      if (isnan(x)) {
+        p_y[i] = x;
+      }
+      /* atan(0.0) == 0.0, acot(0.0) == PI/2 */
+      else if (fpclassify(x) == FP_ZERO) {
+        p_y[i] = (cot) ? PI_HALF : x;
+      }
+      /* atan(+-inf) == +-PI/2, acot(+-inf) == 0.0 */
+      else if (isinf(x)) {
+        if (cot)
+          p_y[i] = 0.0;
+        else
+          p_y[i] = (signbit(x)) ? -PI_HALF : PI_HALF;
+      }
+      /* Results approximates +-PI/2, see arc_tangent() & arc_cotangent(). */
+      else if ((cot) ? abs_d(x) < 0.00001 : abs_d(x) >= 800000) {
+        p_y[i] = (signbit(x)) ? -PI_HALF : PI_HALF;
+      }
+      else
+        batch_add(&batch, i, (cot) ? 1.0 / x : x);
+    }
+
+    /*
+     * y = x / (1.0 + sqrt(1.0 + x^2)), the square root is computed with
+     * default sigdig same as in arc_tangent().
+     */
+    for (size_t j = 0; j < batch.count; j++)
+      batch.aux[j] = 1.0 + (batch.x[j] * batch.x[j]);
+
+    sqrroot_batch_fe(batch.aux, batch.y, batch.err, batch.count,
+                     DEFAULT_SIGDIG, &inner);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      batch.y[j] = batch.x[j] / (1.0 + batch.y[j]);
+      batch.aux[j] = batch.y[j];
+    }
+
+    mclrn_expan_batch(batch.aux, batch.y, batch.err, batch.count, arc_tan,
+                      sigdig, &inner);
+
+    for (size_t j = 0; j < batch.count; j++)
+      p_y[batch.index[j]] = batch.y[j] * 2.0;
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_tangent().
+ */
+void arc_tangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                       int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  /* No value raises any FP exception, see arc_tangent_p(). */
+  arc_co_tangent_batch(p_x, p_y, p_err, n, sigdig, false);
+
+  fesetenv(&env);                 /* Restoring FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of arc_cotangent().
+ */
+void arc_cotangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                         int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  /* No value raises any FP exception, see arc_tangent_p(). */
+  arc_co_tangent_batch(p_x, p_y, p_err, n, sigdig, true);
+
+  fesetenv(&env);                 /* Restoring FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_sine() and hyper_cosine() (for true in cos).
+ */
+static void hyper_co_sine_batch(const double *p_x, double *p_y, int *p_err,
+                                size_t n, int sigdig, bool cos,
+                                int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int inner = 0;                  /* Discarded inner FP exceptions. */
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* sinh(+-inf) == +-inf, cosh(+-inf) == inf. */
+      if (isnan(x) || isinf(x))
+        p_y[i] = (cos && isinf(x)) ? abs_d(x) : x;
+      else
+        batch_add(&batch, i, x);
+    }
+
+    for (size_t j = 0; j < batch.count; j++)
+      batch.aux[j] = batch.x[j] * 2;
+
+    expn_batch_fe(batch.aux, batch.y, batch.err, batch.count, sigdig,
+                  &inner);
+    expn_batch_fe(batch.x, batch.aux, batch.err, batch.count, sigdig,
+                  &inner);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      size_t i = batch.index[j];
+
+      /*  (e^(2 * x) +- 1) / (2 * e^(x))  */
+      double numer = (cos) ? batch.y[j] + 1 : batch.y[j] - 1;
+      double denom = batch.aux[j] * 2;
+
+      /* Testing for overflow. */
+      if (isinf(numer) || isinf(denom)) {
+        p_err[i] = ERANGE;
+        *p_except |= FE_OVERFLOW;
+        p_y[i] = (signbit(batch.x[j]) && !cos) ? -HUGE_VAL : HUGE_VAL;
+      }
+      else
+        p_y[i] = numer / denom;
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_sine().
+ */
+void hyper_sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                      int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  hyper_co_sine_batch(p_x, p_y, p_err, n, sigdig, false, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_cosine().
+ */
+void hyper_cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                        int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  hyper_co_sine_batch(p_x, p_y, p_err, n, sigdig, true, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_tangent() and hyper_cotangent() (for true in cot).
+ */
+static void hyper_co_tangent_batch(const double *p_x, double *p_y, int *p_err,
+                                   size_t n, int sigdig, bool cot,
+                                   int *p_except)
+{
+  TS_Batch batch;                 /* Values of actual chunk. */
+  int inner = 0;                  /* Discarded inner FP exceptions. */
+
+  for (size_t k = 0; k < n; k += BATCH_CHUNK) {
+
+    batch.count = 0;
+
+    for (size_t i = k; i < n && i < k + BATCH_CHUNK; i++) {
+      double x = p_x[i];
+
+      p_err[i] = 0;
+
+      /* Relation operations with NaN would fail. tanh(0) == 0. */
+      if (isnan(x) || (fpclassify(x) == FP_ZERO && !cot)) {
+        p_y[i] = x;
+      }
+      /* coth(0) == complex infinity, NaN for real numbers. */
+      else if (fpclassify(x) == FP_ZERO) {
+        p_err[i] = EDOM;
+        *p_except |= FE_INVALID;
+        p_y[i] = -NAN;
+      }
+      /* tanh(+-inf) == coth(+-inf) == +-1.0 */
+      else if (isinf(x)) {
+        p_y[i] = (signbit(x)) ? -1.0 : 1.0;
+      }
+      else
+        batch_add(&batch, i, x);
+    }
+
+    for (size_t j = 0; j < batch.count; j++)
+      batch.aux[j] = batch.x[j] * 2;
+
+    expn_batch_fe(batch.aux, batch.y, batch.err, batch.count, sigdig,
+                  &inner);
+
+    for (size_t j = 0; j < batch.count; j++) {
+      size_t i = batch.index[j];
+      double step = batch.y[j];   /*  e^(2 * x)  */
+
+      /* Huge values approximate to +/- 1.0. */
+      if (isinf(step))
+        p_y[i] = (signbit(batch.x[j])) ? -1.0 : 1.0;
+      else if (cot)
+        p_y[i] = (step + 1) / (step - 1);
+      else
+        p_y[i] = (step - 1) / (step + 1);
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_tangent().
+ */
+void hyper_tangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                         int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  hyper_co_tangent_batch(p_x, p_y, p_err, n, sigdig, false, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/**
+ * Batch version of hyper_cotangent().
+ */
+void hyper_cotangent_batch(const double *p_x, double *p_y, int *p_err,
+                           size_t n, int sigdig)
+{
+  fenv_t env;                     /* FP environment storage. */
+  int except = 0;                 /* FP exceptions of all values. */
+
+  feholdexcept(&env);             /* Backup of FP environment. */
+
+  hyper_co_tangent_batch(p_x, p_y, p_err, n, sigdig, true, &except);
+
+  batch_feupdate(&env, except);   /* Restoring of FP environment. */
+
+  return;
+}
+
+
+/******************************************************************************
+ ~~~[ HEURISTIC FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Heuristic for the exponential function (e^x). This function splits the input
+ * value into x = (k * EXP_TABLE_SIZE + j) * ln(2) / EXP_TABLE_SIZE + r, where
+ * r is from interval of -ln(2) / (2 * EXP_TABLE_SIZE) to the same positive
+ * value, for gaining the best rate of convergence. It uses relations
+ * exp(x+y) = exp(x) * exp(y) and e^(ln(2) * y) = 2^y. The input value is
+ * replaced by r, k is stored into p_exp and 2^(j / EXP_TABLE_SIZE) is
+ * returned, so e^x == ldexp(e^r * returned value, k). The value of |x| has to
+ * be lower than 2^21 * ln(2) / EXP_TABLE_SIZE.
+ */
+static inline double expn_heurstc(double *p_x, int *p_exp)
+{
+  double k = round(*p_x * EXP_N_LN2_INV);   /* Number of parts of ln(2). */
+
+  int parts = (int) k;                      /* Same number as integer. */
+  int j = ((parts % EXP_TABLE_SIZE) + EXP_TABLE_SIZE) % EXP_TABLE_SIZE;
+
+  /* r = x - k * ln(2) / EXP_TABLE_SIZE, without loss of the accuracy. */
+  *p_x = (*p_x - k * LN2_N_HI) - k * LN2_N_LO;
+
+  *p_exp = (parts - j) / EXP_TABLE_SIZE;    /* Exponent of 2. */
+
+  return exp2_table[j];                     /* 2^(j / EXP_TABLE_SIZE) */
+}
+
+
+/**
+ * Heuristic for natural logarithm. This function splits the input value of ln()
+ * into x = m * 2^e, where m is from interval of 1.0 inclusive to 2.0 exclusive,
+ * and finds the closest center c = 1 + j / LN_TABLE_SIZE of the mantissa. The
+ * input value is replaced by m / c, which differs from 1.0 by less than
+ * 1 / (2 * LN_TABLE_SIZE), for gaining the best rate of convergence. The
+ * return value is e * ln(2) + ln(c), which has to be added to the outcome of
+ * natural logarithm of new x to get a proper result of unmodified x.
+ * Computation costs the same for any finite positive input value, including
+ * the subnormal ones.
+ */
+static inline double ln_heurstc(double *p_x)
+{
+  int e;                                /* Exponent of 2. */
+  double m = frexp(*p_x, &e) * 2.0;     /* Mantissa, m == x / 2^e. */
+
+  e--;                                  /* Correction because of m * 2.0. */
+
+  int j = (int) round((m - 1.0) * LN_TABLE_SIZE);   /* Index of the center. */
+
+  /* Mantissa closer to 2.0 than to the last center, m / 2 is closer to 1.0. */
+  if (j == LN_TABLE_SIZE) {
+    m /= 2.0;
+    e++;
+    j = 0;
+  }
+
+  *p_x = m * ln_recip_table[j];         /* New value closest to 1.0. */
+
+  /* ln(2) * e, without loss of the accuracy, see expn_heurstc(). */
+  double k = (double) e * EXP_TABLE_SIZE;
+
+  return (k * LN2_N_HI + ln_center_table[j]) + k * LN2_N_LO;
+}
+
+
+/**
+ * Heuristic for sine & cosine functions. This function reduces the input value
+ * into x = k * PI / 2 + r, where r is from interval of -PI / 4 to PI / 4,
+ * because of periodicity of trigonometric functions. Sine and cosine functions
+ * convergence is the fastest for this interval. The input value is replaced by
+ * r and the quadrant k modulo 4 is returned, see co_sine_series(). Value of
+ * PI / 2 is split into three parts for the reduction to be accurate; the
+ * values bigger than PI_HALF_REM_LIMIT are reduced by pi_half_rem().
+ */
+static inline int co_sine_heurstc(double *p_x)
+{
+  double x = abs_d(*p_x);           /* Reduction is done for |x|. */
+  int quadrant;                     /* Quadrant of the value. */
+
+  if (x < PI_HALF_REM_LIMIT) {
+    double k = round(x * PI_HALF_INV);    /* Number of PI / 2 parts. */
+
+    quadrant = (int) k % 4;
+    x = ((x - k * PI_HALF_1) - k * PI_HALF_2) - k * PI_HALF_3;
+  }
+  else {
+    x = pi_half_rem(x, &quadrant);
+  }
+
+  /* sin(-x) == -sin(x), so -x lies in the opposite quadrant. */
+  if (signbit(*p_x)) {
+    x = -x;
+    quadrant = (4 - quadrant) % 4;
+  }
+
+  *p_x = x;
+
+  return quadrant;
+}
+
+
+/**
+ * Heuristic for square root. This function splits the input value into
+ * x = m * 2^e, where e is even and m is from interval of 0.25 inclusive to 1.0
+ * exclusive, so sqrt(x) == sqrt(m) * 2^(e / 2). The input value is replaced by
+ * m, e / 2 is stored into p_exp and the linear approximation of sqrt(m) is
+ * returned as the initial value of Newton's method. Computation costs the same
+ * for any finite positive input value, including the subnormal ones.
+ */
+static inline double sqrt_heurstc(double *p_x, int *p_exp)
+{
+  int e;                                /* Exponent of 2. */
+  double m = frexp(*p_x, &e);           /* Mantissa, m == x / 2^e. */
+
+  /* Odd exponent, m / 2 is from interval of 0.25 to 0.5. */
+  if (e % 2 != 0) {
+    m /= 2.0;
+    e++;
+  }
+
+  *p_x = m;
+  *p_exp = e / 2;
+
+  return SQRT_SEED_0 + SQRT_SEED_1 * m;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Computes value of Maclaurin series (special type of Taylor series where
+ * a == 0) for the most elementary expansions. The exact expansion depends on
+ * values in given TS_Maclaur_series structure. When true is used for the 
+ * oscillate, then function computes with oscillating sign of every addition.
+ * When true is used for use_fact, then function computes with factorial as a
+ * denominator. Sigdig represents number of digits of result that are
+ * significant.
+ */
+static inline double mclrn_expan(double x, TS_Maclaur_series expan, int sigdig)
+{
+  if (isnan(x))           /* Relation operations with NaN would fail. */
+    return x;
+
+  /* 1*10^(-sigdig) is the factor of new epsilon of every step. */
+  expan.sum = mclrn_steps(x, expan, xsciexp(1.0, -sigdig));
+
+  return mclrn_result(expan.sum, &errno);
+}
+
+
+/**
+ * Performs the steps of Maclaurin series expansion described in mclrn_expan()
+ * until the difference of two successive sums is not bigger than the epsilon
+ * (given by eps_factor) or until the sum is not normal number. Returns the
+ * final sum.
+ */
+static inline double mclrn_steps(double x, TS_Maclaur_series expan,
+                                 double eps_factor)
+{
+  double sum_pred;        /* Sum of all values before. */
+  double x2;              /* Value representing +/-(x^2), see below. */
+  double eps;             /* Wanted accuracy (epsilon) of actual step. */
+
+  sum_pred = 0.0;                       /* No sum yet. */
+
+
+  /*
+   * Preprocess the value x^2. The sign of x2 depends on if there was a
+   * requirement for an oscillation of the sign.
+   */
+  if (expan.oscillate == true)
+    x2 = -(x * x);        /* Expansion with sign oscillation of each step.*/
+  else
+    x2 = x * x;           /* Expansion without sign oscillation. */
 
 
   /*
@@ -1166,47 +2407,525 @@ static inline double mclrn_expan(double x, TS_Maclaur_series expan, int sigdig)
 
   }
 
+  return expan.sum;
+}
 
-  int sum_cls = fpclassify(expan.sum);            /* Result classification. */
 
-  /*
-   * Detection of an error by return value of fpclassify(). Sets errno and
-   * raises exception correspondingly to the error, if there was any, and
-   * returns proper value as described in "man 7 math_error".
-   */
+/**
+ * Checks the final sum of Maclaurin series expansion. Detection of an error is
+ * done by return value of fpclassify(). Stores errno value into p_err and
+ * raises exception correspondingly to the error, if there was any, and returns
+ * proper value as described in "man 7 math_error".
+ */
+static inline double mclrn_result(double sum, int *p_err)
+{
+  int except = 0;                     /* Exceptions of the result. */
+
+  sum = mclrn_status(sum, p_err, &except);
+
+  if (except != 0)
+    feraiseexcept(except);
+
+  return sum;
+}
+
+
+/**
+ * Same as mclrn_result(), but FP exceptions are not raised, they are added into
+ * p_except instead. Used by batch functions.
+ */
+static inline double mclrn_status(double sum, int *p_err,
+                                  int *p_except)
+{
+  int sum_cls = fpclassify(sum);                  /* Result classification. */
+
   switch (sum_cls) {
 
     /* Indeterminate form appeared. */
     case FP_NAN :
-      errno = ERANGE;
-      feraiseexcept(FE_INVALID);
-      return expan.sum;
+      *p_err = ERANGE;
+      *p_except |= FE_INVALID;
+      return sum;
 
     /* Overflow occurred. */
     case FP_INFINITE :
-      errno = ERANGE;
-      feraiseexcept(FE_OVERFLOW);
-      return (signbit(expan.sum)) ? -HUGE_VAL : HUGE_VAL;
+      *p_err = ERANGE;
+      *p_except |= FE_OVERFLOW;
+      return (signbit(sum)) ? -HUGE_VAL : HUGE_VAL;
 
     /* Underflow occurred. */
     case FP_SUBNORMAL :
-      errno = ERANGE;
-      feraiseexcept(FE_UNDERFLOW);
+      *p_err = ERANGE;
+      *p_except |= FE_UNDERFLOW;
       return 0.0;
 
     /* Zero and other results are correct. */
     case FP_ZERO :
     case FP_NORMAL :
-      return expan.sum;
+      return sum;
 
     /* Default only for warning disposal. This case should never occur! */
     default :
-      return expan.sum;
+      return sum;
       break;
   }
 }
 
 
+/**
+ * Batch version of mclrn_expan(). Computes n expansions given by expan for
+ * values from p_x, but the initial sum (and numerator) of every expansion is
+ * taken from p_sum, where the result is stored afterwards. The errno value of
+ * every expansion is stored into p_err (0 if there was no error). Expansions
+ * run in SIMD lanes, if the processor supports it, and every lane stops
+ * independently after reaching its' epsilon, so the results are same as the
+ * results of mclrn_expan().
+ */
+static void mclrn_expan_batch(const double *p_x, double *p_sum, int *p_err,
+                              size_t n, TS_Maclaur_series expan, int sigdig,
+                              int *p_except)
+{
+  double eps_factor = xsciexp(1.0, -sigdig);    /* 1*10^(-sigdig) */
+
+  size_t i = 0;                                 /* Values done by SIMD. */
+
+#ifdef MATHLIB_SIMD
+  if (__builtin_cpu_supports("avx512f"))
+    i = mclrn_steps_avx512(p_x, p_sum, n, expan, eps_factor);
+  else if (__builtin_cpu_supports("avx2"))
+    i = mclrn_steps_avx2(p_x, p_sum, n, expan, eps_factor);
+#endif
+
+  /* Rest of values (or all of them) without SIMD. */
+  for (; i < n; i++) {
+    expan.sum = p_sum[i];
+    expan.numer = p_sum[i];
+
+    p_sum[i] = mclrn_steps(p_x[i], expan, eps_factor);
+  }
+
+  for (i = 0; i < n; i++) {
+    p_err[i] = 0;
+
+    if (isnan(p_x[i]))      /* Relation operations with NaN would fail. */
+      p_sum[i] = p_x[i];
+    else
+      p_sum[i] = mclrn_status(p_sum[i], &p_err[i], p_except);
+  }
+
+  return;
+}
+
+
+#ifdef MATHLIB_SIMD
+/**
+ * AVX2 version of mclrn_steps() for 4 values at once, see mclrn_expan_batch().
+ * The denominator is same for every lane, only the numerators and sums differ.
+ * Lanes, which reached their epsilon, keep their sums unchanged until all
+ * lanes are done. Their numerators are zeroed once, when they finish,
+ * otherwise they would sink to subnormal values, which very slow down the
+ * computation of other lanes. (Zeroing in every step would chain numerators
+ * with the comparisons.) Returns the number of processed values (the rest is
+ * lower than 4).
+ */
+__attribute__((target("avx2")))
+static size_t mclrn_steps_avx2(const double *p_x, double *p_sum, size_t n,
+                               TS_Maclaur_series expan, double eps_factor)
+{
+  const __m256d sign = _mm256_set1_pd(-0.0);      /* Mask of sign bits. */
+  const __m256d eps_f = _mm256_set1_pd(eps_factor);
+  const __m256d norm_min = _mm256_set1_pd(DBL_MIN);
+  const __m256d norm_max = _mm256_set1_pd(DBL_MAX);
+
+  size_t i;
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    __m256d x = _mm256_loadu_pd(p_x + i);
+    __m256d x2 = _mm256_mul_pd(x, x);
+
+    if (expan.oscillate == true)
+      x2 = _mm256_xor_pd(x2, sign);               /* -(x^2) */
+
+    __m256d sum = _mm256_loadu_pd(p_sum + i);
+    __m256d numer = sum;
+
+    /* Lanes with NaN are skipped, see mclrn_expan_batch(). */
+    __m256d active = _mm256_cmp_pd(x, x, _CMP_ORD_Q);
+    int lanes = _mm256_movemask_pd(active);       /* Actually active lanes. */
+
+    double n_act = expan.n;                       /* Common N. */
+    double denom = expan.denom;                   /* Common denominator. */
+
+    do {
+      if (expan.use_fact == true) {
+        n_act += 2.0;
+        denom *= n_act * (n_act - 1.0);
+      }
+      else
+        denom += 2.0;
+
+      __m256d sum_pred = sum;
+
+      numer = _mm256_mul_pd(numer, x2);
+      sum = _mm256_add_pd(sum, _mm256_div_pd(numer, _mm256_set1_pd(denom)));
+      sum = _mm256_blendv_pd(sum_pred, sum, active);
+
+      __m256d sum_abs = _mm256_andnot_pd(sign, sum);
+      __m256d eps = _mm256_andnot_pd(sign, _mm256_mul_pd(sum, eps_f));
+      __m256d diff = _mm256_andnot_pd(sign, _mm256_sub_pd(sum, sum_pred));
+
+      /* Same condition as in mclrn_steps(), isnormal() included. */
+      active = _mm256_and_pd(active,
+                             _mm256_cmp_pd(sum_abs, norm_min, _CMP_GE_OQ));
+      active = _mm256_and_pd(active,
+                             _mm256_cmp_pd(sum_abs, norm_max, _CMP_LE_OQ));
+      active = _mm256_and_pd(active, _mm256_cmp_pd(diff, eps, _CMP_GT_OQ));
+
+      /* Some lanes have just finished, from now on they add only 0.0. */
+      if (_mm256_movemask_pd(active) != lanes) {
+        lanes = _mm256_movemask_pd(active);
+        numer = _mm256_and_pd(numer, active);
+      }
+
+    } while (lanes != 0);
+
+    _mm256_storeu_pd(p_sum + i, sum);
+  }
+
+  return i;
+}
+
+
+/**
+ * AVX-512 version of mclrn_steps_avx2() for 8 values at once.
+ */
+__attribute__((target("avx512f")))
+static size_t mclrn_steps_avx512(const double *p_x, double *p_sum, size_t n,
+                                 TS_Maclaur_series expan, double eps_factor)
+{
+  const long long sign = LLONG_MIN;               /* Sign bit. */
+  const __m512d eps_f = _mm512_set1_pd(eps_factor);
+  const __m512d norm_min = _mm512_set1_pd(DBL_MIN);
+  const __m512d norm_max = _mm512_set1_pd(DBL_MAX);
+
+  size_t i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m512d x = _mm512_loadu_pd(p_x + i);
+    __m512d x2 = _mm512_mul_pd(x, x);
+
+    if (expan.oscillate == true)                  /* -(x^2) */
+      x2 = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(x2),
+                                                _mm512_set1_epi64(sign)));
+
+    __m512d sum = _mm512_loadu_pd(p_sum + i);
+    __m512d numer = sum;
+
+    /* Lanes with NaN are skipped, see mclrn_expan_batch(). */
+    __mmask8 active = _mm512_cmp_pd_mask(x, x, _CMP_ORD_Q);
+    __mmask8 lanes = active;                      /* Actually active lanes. */
+
+    double n_act = expan.n;                       /* Common N. */
+    double denom = expan.denom;                   /* Common denominator. */
+
+    do {
+      if (expan.use_fact == true) {
+        n_act += 2.0;
+        denom *= n_act * (n_act - 1.0);
+      }
+      else
+        denom += 2.0;
+
+      __m512d sum_pred = sum;
+
+      numer = _mm512_mul_pd(numer, x2);
+      sum = _mm512_mask_add_pd(sum, active, sum,
+                               _mm512_div_pd(numer, _mm512_set1_pd(denom)));
+
+      __m512d sum_abs = _mm512_abs_pd(sum);
+      __m512d eps = _mm512_abs_pd(_mm512_mul_pd(sum, eps_f));
+      __m512d diff = _mm512_abs_pd(_mm512_sub_pd(sum, sum_pred));
+
+      /* Same condition as in mclrn_steps(), isnormal() included. */
+      active = _mm512_mask_cmp_pd_mask(active, sum_abs, norm_min, _CMP_GE_OQ);
+      active = _mm512_mask_cmp_pd_mask(active, sum_abs, norm_max, _CMP_LE_OQ);
+      active = _mm512_mask_cmp_pd_mask(active, diff, eps, _CMP_GT_OQ);
+
+      /* Some lanes have just finished, from now on they add only 0.0. */
+      if (active != lanes) {
+        lanes = active;
+        numer = _mm512_maskz_mov_pd(active, numer);
+      }
+
+    } while (lanes != 0);
+
+    _mm512_storeu_pd(p_sum + i, sum);
+  }
+
+  return i;
+}
+#endif
+
+
+/**
+ * Computes sine of x (for even quadrant) or cosine of x (for odd quadrant),
+ * where x is the value reduced by co_sine_heurstc() and quadrant is its'
+ * return value, eventually increased by 1 for cosine. Uses these relations:
+ * sin(r + PI / 2) == cos(r) and sin(r + PI) == -sin(r).
+ */
+static inline double co_sine_series(double x, int quadrant, int sigdig)
+{
+  double y;                       /* Sine or cosine of x. */
+
+  if (quadrant & 1)
+    y = poly_eval(x * x, cos_coef, cos_terms[sigdig - 1]);
+  else
+    y = poly_eval(x * x, sin_coef, sin_terms[sigdig - 1]) * x;
+
+  y = mclrn_result(y, &errno);    /* Result classification. */
+
+  return (quadrant & 2) ? -y : y;
+}
+
+
+/**
+ * Evaluates polynomial kernel given by the field of coefficients p_coef (the
+ * absolute one first) with the fixed number of terms in point x by Horner's
+ * scheme. No branching depends on the value of x, see the *_coef fields.
+ */
+static inline double poly_eval(double x, const double *p_coef, int terms)
+{
+  double y = p_coef[terms - 1];   /* Coefficient of the highest power. */
+
+  for (int i = terms - 2; i >= 0; i--)
+    y = y * x + p_coef[i];
+
+  return y;
+}
+
+
+/**
+ * Batch version of poly_eval() for n values. When square is true, the
+ * polynomial is evaluated in x^2 instead of x. The loop over values is the
+ * inner one, so the number of its' iterations is the same for every power and
+ * it can be vectorized by the compiler. Results are the same as the results of
+ * poly_eval().
+ */
+static void poly_eval_batch(const double *p_x, double *p_y, size_t n,
+                            const double *p_coef, int terms, bool square)
+{
+  for (size_t j = 0; j < n; j++)
+    p_y[j] = p_coef[terms - 1];
+
+  for (int i = terms - 2; i >= 0; i--) {
+    if (square) {
+      for (size_t j = 0; j < n; j++)
+        p_y[j] = p_y[j] * (p_x[j] * p_x[j]) + p_coef[i];
+    }
+    else {
+      for (size_t j = 0; j < n; j++)
+        p_y[j] = p_y[j] * p_x[j] + p_coef[i];
+    }
+  }
+
+  return;
+}
+
+
+/**
+ * Payne-Hanek reduction of huge positive value x by PI / 2. The value is split
+ * into x = m * 2^e, where m is 53 bit integer, and multiplied by the window of
+ * TWO_OVER_PI_WINDOW words of 2 / PI. The window starts at the word, where all
+ * preceding words would add only multiples of 4 to x * 2 / PI. Two lowest bits
+ * of integer part of the product are stored into p_quadrant and the fraction,
+ * adjusted into interval of -0.5 to 0.5, is returned multiplied by PI / 2.
+ */
+static double pi_half_rem(double x, int *p_quadrant)
+{
+  int e;                                    /* Exponent of 2. */
+  uint64_t m = (uint64_t) ldexp(frexp(x, &e), 53);    /* 53 bit mantissa. */
+
+  e -= 53;                                  /* x == m * 2^e. */
+
+  int first = (e >= 2) ? (e - 2) / 32 : 0;  /* First word of the window. */
+  int point = 32 * TWO_OVER_PI_WINDOW - (e - 32 * first);   /* Binary point. */
+
+  /* Product of mantissa and the window, least significant word first. */
+  uint32_t prod[TWO_OVER_PI_WINDOW + 4] = {0};
+  uint32_t m_words[2] = {(uint32_t) m, (uint32_t) (m >> 32)};
+
+  for (int i = 0; i < TWO_OVER_PI_WINDOW; i++) {
+    uint64_t word = two_over_pi[first + TWO_OVER_PI_WINDOW - 1 - i];
+    uint64_t carry = 0;
+
+    for (int j = 0; j < 2; j++) {
+      carry += word * m_words[j] + prod[i + j];
+      prod[i + j] = (uint32_t) carry;
+      carry >>= 32;
+    }
+
+    prod[i + 2] = (uint32_t) carry;
+  }
+
+  /* Quadrant and 128 bits of the fraction. */
+  int quadrant = (int) (bits_u64(prod, point) & 3);
+  uint64_t frac_hi = bits_u64(prod, point - 64);
+  uint64_t frac_lo = bits_u64(prod, point - 128);
+
+  double sign = 1.0;
+
+  /* Fraction >= 0.5? Then r == fraction - 1 from the next quadrant. */
+  if (frac_hi >> 63) {
+    frac_lo = ~frac_lo + 1;
+    frac_hi = ~frac_hi + (frac_lo == 0);
+    sign = -1.0;
+    quadrant = (quadrant + 1) % 4;
+  }
+
+  *p_quadrant = quadrant;
+
+  double frac = ldexp((double) frac_hi, -64) + ldexp((double) frac_lo, -128);
+
+  return sign * frac * PI_HALF;
+}
+
+
+/**
+ * Returns 64 bits of multi-word number (least significant word first), which
+ * starts with the bit at position pos. The number has to have at least two
+ * more words after the word containing this bit.
+ */
+static inline uint64_t bits_u64(const uint32_t *p_num, int pos)
+{
+  int i = pos / 32;                 /* Word containing the bit. */
+  int offset = pos % 32;            /* Position of the bit in the word. */
+
+  uint64_t bits = ((uint64_t) p_num[i + 1] << 32 | p_num[i]) >> offset;
+
+  if (offset != 0)
+    bits |= (uint64_t) p_num[i + 2] << (64 - offset);
+
+  return bits;
+}
+
+
+/**
+ * Checks the result of expn(). Detection of an error is done by return value
+ * of fpclassify(). Stores errno value into p_err and raises exception
+ * correspondingly to the error, if there was any, and returns proper value as
+ * described in "man 7 math_error".
+ */
+static inline double expn_result(double x, int *p_err)
+{
+  int except = 0;                     /* Exceptions of the result. */
+
+  x = expn_status(x, p_err, &except);
+
+  if (except != 0)
+    feraiseexcept(except);
+
+  return x;
+}
+
+
+/**
+ * Same as expn_result(), but FP exceptions are not raised, they are added into
+ * p_except instead. Used by batch functions.
+ */
+static inline double expn_status(double x, int *p_err,
+                                 int *p_except)
+{
+  int xcls = fpclassify(x);           /* Result classification. */
+
+  switch (xcls) {
+    /* Indeterminate form appeared. */
+    case FP_NAN :
+      *p_err = ERANGE;
+      *p_except |= FE_INVALID;
+      return x;
+
+    /* Overflow occurred. */
+    case FP_INFINITE :
+      *p_err = ERANGE;
+      *p_except |= FE_OVERFLOW;
+      return HUGE_VAL;
+
+    /* Underflow occurred. */
+    case FP_ZERO :
+    case FP_SUBNORMAL :
+      *p_err = ERANGE;
+      *p_except |= FE_UNDERFLOW;
+      return 0.0;
+
+    /* Zero and other results are correct. */
+    case FP_NORMAL :
+      return x;
+
+    /* Default only for warning disposal. This case should never occur! */
+    default :
+      return x;
+  }
+}
+
+
+/**
+ * Adds value x from given position of the batch into the batch structure.
+ */
+static inline void batch_add(TS_Batch *p_batch, size_t index, double x)
+{
+  p_batch->index[p_batch->count] = index;
+  p_batch->x[p_batch->count] = x;
+  p_batch->count++;
+
+  return;
+}
+
+
+/**
+ * Stores results and errno values from the batch structure into their
+ * positions of the batch.
+ */
+static inline void batch_store(TS_Batch *p_batch, double *p_y, int *p_err)
+{
+  for (size_t j = 0; j < p_batch->count; j++) {
+    p_y[p_batch->index[j]] = p_batch->y[j];
+    p_err[p_batch->index[j]] = p_batch->err[j];
+  }
+
+  return;
+}
+
+
+/**
+ * Restores FP environment saved by feholdexcept() at the start of batch
+ * function and raises FP exceptions of all computed values at once.
+ */
+static inline void batch_feupdate(const fenv_t *p_env, int except)
+{
+  fesetenv(p_env);
+
+  if (except != 0)
+    feraiseexcept(except);
+
+  return;
+}
+
+
+/**
+ * Returns given number of significant digits corrected the same way as by
+ * va_sigdig() macro.
+ */
+static inline int sigdig_check(int sigdig)
+{
+  if (sigdig < 1)
+    return DEFAULT_SIGDIG;              /* Wrong sigdig = default value. */
+  else if (sigdig > DBL_DIG)
+    return DBL_DIG;                     /* Maximal possible sigdig. */
+  else
+    return sigdig;
+}
+
+
 /******************************************************************************
  ***[ END OF MATHLIB.C ]*******************************************************
  ******************************************************************************/
@@ -36,8 +36,12 @@
 
 /* Used in some inline functions below. */
 #include <math.h>
+/* Type bool is used by TS_Maclaur_series structure. */
+#include <stdbool.h>
 /* DBL_DIG value is used below for DEFAULT_SIGDIG initialization. */
 #include <float.h>
+/* Type size_t is used by batch functions. */
+#include <stddef.h>
 
 /******************************************************************************
  ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -95,6 +99,39 @@ typedef struct maclaur_series {
  ******************************************************************************/
 
 double xsciexp(double x, int y);              /* x * 10^y */
+
+/*
+ * Argument sigdig of functions below represents number of required significant
+ * digits of the result, see proj2_mathlib.c.
+ */
+double expn_p(double x, int sigdig);
+double ln_p(double x, int sigdig);
+double logax_p(double x, double base, int sigdig);
+double sqrroot_p(double x, int sigdig);
+
+double sine_p(double x, int sigdig);
+double arc_sine_p(double x, int sigdig);
+double hyper_sine_p(double x, int sigdig);
+
+double cosine_p(double x, int sigdig);
+double arc_cosine_p(double x, int sigdig);
+double hyper_cosine_p(double x, int sigdig);
+
+double arc_tangent_p(double x, int sigdig);
+double hyper_tangent_p(double x, int sigdig);
+
+double arc_cotangent_p(double x, int sigdig);
+double hyper_cotangent_p(double x, int sigdig);
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF VARIADIC FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Same as primary functions above, but sigdig is optional argument, see
+ * proj2_mathlib.c.
+ */
 double expn(double x, ...);                   /* Exponential function. */
 double ln(double x, ...);                     /* Natural logarithm of x. */
 double logax(double x, double base, ...);     /* General logarithm of x. */
@@ -115,6 +152,48 @@ double arc_cotangent(double x, ...);          /* Inverse cotangent of x. */
 double hyper_cotangent(double x, ...);        /* Hyperbolical cotangent of x. */
 
 
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF BATCH FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Batch versions of primary functions above. Each computes n values of p_x
+ * into p_y and stores the errno value of every computation into p_err. FP
+ * environment is saved only once and FP exceptions of all values are raised
+ * at once at the end.
+ */
+void expn_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                int sigdig);
+void ln_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+              int sigdig);
+void sqrroot_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                   int sigdig);
+
+void sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                int sigdig);
+void arc_sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                    int sigdig);
+void hyper_sine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                      int sigdig);
+
+void cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                  int sigdig);
+void arc_cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                      int sigdig);
+void hyper_cosine_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                        int sigdig);
+
+void arc_tangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                       int sigdig);
+void hyper_tangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                         int sigdig);
+
+void arc_cotangent_batch(const double *p_x, double *p_y, int *p_err, size_t n,
+                         int sigdig);
+void hyper_cotangent_batch(const double *p_x, double *p_y, int *p_err,
+                           size_t n, int sigdig);
+
+
 /******************************************************************************
  ~~~[ FUNCTIONAL PROTOTYPES OF SHARED INLINE FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~
  ******************************************************************************/
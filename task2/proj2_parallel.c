@@ -0,0 +1,705 @@
+/**
+ * File:          proj2_parallel.c
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #2 - Iterative calculations
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This module contains functions for computing of values of
+ *                input by multiple threads. Input is split into chunks at the
+ *                boundaries of values, every chunk is read and computed by
+ *                its' own thread into its' own output buffer and the output
+ *                buffers are then written in the input order. Length of
+ *                broken line is computed by parallel prefix sum of lengths of
+ *                segments in blocks of points.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj2.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+
+/******************************************************************************
+ ***[ START OF PROJ2_PARALLEL.C ]**********************************************
+ ******************************************************************************/
+
+/* Needed for sysconf() with -std=c99. */
+#define _POSIX_C_SOURCE 200809L
+
+/******************************************************************************
+ ~~~[ HEADER FILES ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "proj2_bufio.h"
+#include "proj2_geomlib.h"
+#include "proj2_parallel.h"
+
+
+/******************************************************************************
+ ~~~[ LOCAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Minimal size of input data of one chunk, multiple of BIN_VALUE_SIZE. */
+static const size_t CHUNK_SIZE = 1048576;
+
+/* Number of values computed at once by one thread. */
+#define CHUNK_BATCH 1024
+
+/*
+ * Number of points of one block of broken line. Sums don't depend on number
+ * of threads, because the blocks are always the same.
+ */
+static const size_t TRACK_SIZE = 65536;
+
+
+/******************************************************************************
+ ~~~[ LOCAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/*
+ * Structure containing one chunk of input values and the results of its'
+ * computation.
+ */
+typedef struct chunk {
+  TF_Batch p_batch;         /* Batch version of the function. */
+  int sigdig;               /* Required significant digits. */
+
+  TE_Format format;         /* Format of input values. */
+  const char *p_values;     /* Input values of the chunk. */
+  size_t length;            /* Length of input values. */
+
+  char *p_data;             /* Memory for input values read from stream. */
+  size_t size;              /* Size of memory of input values. */
+
+  TS_Outbuffer outbuff;     /* Computed values. */
+
+  int *p_warn;              /* Errno values of results, which are not 0. */
+  size_t warns;             /* Number of errno values. */
+  size_t warn_size;         /* Size of memory of errno values. */
+
+  /*
+   * EXIT_SUCCESS if whole chunk was computed or EXIT_FAILURE upon error, which
+   * is stored in err then.
+   */
+  int ret_val;
+  int err;
+} TS_Chunk;
+
+
+/*
+ * Structure containing one block of points of broken line and the results of
+ * its' computation.
+ */
+typedef struct track {
+  TS_Lobl lobl;             /* Predecessor of the first point. */
+
+  /*
+   * Sum of lengths of segments of the block after lbl_total(), then sum of
+   * previous blocks, which is used as the beginning by lbl_scan().
+   */
+  TS_Csum sum;
+
+  double *p_x;              /* Coordinates of x. */
+  double *p_y;              /* Coordinates of y. */
+  double *p_len;            /* Lengths of segments, then sums after each. */
+  int *p_err;               /* Errno values of the computation. */
+  int *p_scan_err;          /* Errno values of the reading. */
+  bool *p_nan;              /* Was any input value not a number? */
+  size_t n;                 /* Number of points. */
+
+  TS_Outbuffer outbuff;     /* Computed values. */
+
+  size_t warn;              /* First point with warning, n if there's none. */
+
+  int ret_val;              /* EXIT_SUCCESS or EXIT_FAILURE upon error. */
+  int err;                  /* Errno value of the error. */
+} TS_Track;
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF LOCAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+static int chunk_read(TS_Chunk *p_chunk, TS_Inbuffer *p_inbuff, bool *p_eof);
+
+static void *chunk_compute(void *p_arg);
+
+static int chunk_warn(TS_Chunk *p_chunk, int err);
+
+static int track_init(TS_Track *p_track, TE_Format format);
+
+static void track_free(TS_Track *p_track);
+
+static void *track_total(void *p_arg);
+
+static void *track_scan(void *p_arg);
+
+static int threads_count(int threads);
+
+static void threads_run(void *(*p_func)(void *), void *p_items,
+                        size_t item_size, int count);
+
+
+/******************************************************************************
+ ~~~[ PRIMARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Same as func_w() function in proj2.c module, but the input values from given
+ * input buffer are computed by given batch function in given number of threads
+ * (0 stands for number of online processors) and written into given output
+ * buffer. Chunks of memory-mapped input are computed in place, stream is read
+ * into chunks. Results and warnings of computation are written in the input
+ * order. Returns EXIT_SUCCESS or EXIT_FAILURE and sets errno upon error.
+ */
+int process_values_mt(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff,
+                      TF_Batch p_batch, int sigdig, int threads)
+{
+  TS_Chunk chunks[MAX_THREADS];   /* Chunks of one round of computation. */
+
+  bool eof = false;               /* Was the whole input read? */
+  bool done = false;              /* Was the processing stopped? */
+
+  int ret_val = EXIT_SUCCESS;     /* Return value. */
+  int err = 0;                    /* Backup of errno. */
+
+  int active;                     /* Number of chunks in actual round. */
+  int t;                          /* Iteration counter. */
+
+
+  threads = threads_count(threads);
+
+  /* Initialization of chunks. */
+  for (t = 0; t < threads; t++) {
+    chunks[t].p_batch = p_batch;
+    chunks[t].sigdig = sigdig;
+    chunks[t].format = p_inbuff->format;
+    chunks[t].p_values = NULL;
+    chunks[t].length = 0;
+    chunks[t].p_data = NULL;
+    chunks[t].size = 0;
+    chunks[t].p_warn = NULL;
+    chunks[t].warns = 0;
+    chunks[t].warn_size = 0;
+
+    if (outbuff_init(&chunks[t].outbuff, NULL, p_outbuff->format)
+        == EXIT_FAILURE) {
+      err = errno;
+      ret_val = EXIT_FAILURE;
+      threads = t;                /* Only initialized chunks are freed. */
+      done = true;
+      break;
+    }
+  }
+
+
+  /*
+   * Every round reads one chunk for every thread, computes them in parallel
+   * and writes the results in the input order.
+   */
+  while (done == false && eof == false) {
+
+    /* Reading of chunks. */
+    for (active = 0; active < threads && eof == false; active++) {
+
+      if (chunk_read(&chunks[active], p_inbuff, &eof) == EXIT_FAILURE) {
+        err = errno;
+        ret_val = EXIT_FAILURE;
+        done = true;
+        break;                    /* Already read chunks are processed. */
+      }
+
+      if (chunks[active].length == 0)
+        break;                    /* Nothing more to compute. */
+    }
+
+    threads_run(chunk_compute, chunks, sizeof(TS_Chunk), active);
+
+    /* Writing of results and warnings in the input order. */
+    for (t = 0; t < active; t++) {
+
+      if (outbuff_write(p_outbuff, chunks[t].outbuff.p_data,
+                        chunks[t].outbuff.used) == EXIT_FAILURE) {
+        err = errno;
+        ret_val = EXIT_FAILURE;
+        done = true;
+        break;
+      }
+
+      for (size_t i = 0; i < chunks[t].warns; i++)
+        fprintf(stderr, "proj2: warning: %s\n", strerror(chunks[t].p_warn[i]));
+
+      if (chunks[t].ret_val == EXIT_FAILURE) {
+        err = chunks[t].err;
+        ret_val = EXIT_FAILURE;
+        done = true;              /* No more chunks are written. */
+        break;
+      }
+    }
+  }
+
+  /* Dispose of chunks. */
+  for (t = 0; t < threads; t++) {
+    free((void *) chunks[t].p_data);
+    free((void *) chunks[t].p_warn);
+    outbuff_free(&chunks[t].outbuff);
+  }
+
+  errno = err;
+
+  return ret_val;
+}
+
+
+/**
+ * Same as lbl_w() function in proj2.c module, but the sums are computed by
+ * given number of threads (0 stands for number of online processors). Points
+ * are read in blocks of TRACK_SIZE points, one block for every thread. Lengths
+ * of segments and their compensated sum are computed for every block in
+ * parallel, sums of previous blocks are added in the input order and then the
+ * sums after each point are computed and printed in parallel again. Sums are
+ * deterministic, but they can differ from lbl_w() in the last digits. Returns
+ * EXIT_SUCCESS or EXIT_FAILURE and sets errno upon error.
+ */
+int process_lbl_mt(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff,
+                   int threads)
+{
+  TS_Track tracks[MAX_THREADS];   /* Blocks of one round of computation. */
+
+  TS_Csum sum = {0.0, 0.0};       /* Sum of all previous blocks. */
+
+  double x_last = 0.0;            /* Last read point. */
+  double y_last = 0.0;
+
+  bool first = true;              /* Is the first point going to be read? */
+
+  bool print_warn = true;         /* Prints warning only once. */
+  bool eof = false;               /* Was the end of input reached? */
+
+  int ret_val = EXIT_SUCCESS;     /* Return value. */
+  int err = 0;                    /* Backup of errno. */
+
+  int active;                     /* Number of blocks in actual round. */
+  int t;                          /* Iteration counter. */
+
+
+  threads = threads_count(threads);
+
+  /* Initialization of blocks. */
+  for (t = 0; t < threads; t++) {
+    if (track_init(&tracks[t], p_outbuff->format) == EXIT_FAILURE) {
+      err = errno;
+      ret_val = EXIT_FAILURE;
+      threads = t;                /* Only initialized blocks are freed. */
+      eof = true;
+      break;
+    }
+  }
+
+  while (eof == false) {
+
+    /* Reading of blocks, the predecessor is the last point before. */
+    for (active = 0; active < threads && eof == false; active++) {
+      TS_Track *p_track = &tracks[active];
+
+      p_track->n = breadpoints(p_inbuff, p_track->p_x, p_track->p_y,
+                               p_track->p_scan_err, p_track->p_nan,
+                               TRACK_SIZE, &eof);
+
+      if (eof == true && errno != 0) {
+        err = errno;
+        ret_val = EXIT_FAILURE;   /* Already read points are processed. */
+      }
+
+      if (p_track->n == 0)
+        break;
+
+      /* The first point has no predecessor. */
+      if (first == true) {
+        x_last = p_track->p_x[0];
+        y_last = p_track->p_y[0];
+        first = false;
+      }
+
+      p_track->lobl.x_bef = x_last;
+      p_track->lobl.y_bef = y_last;
+
+      x_last = p_track->p_x[p_track->n - 1];
+      y_last = p_track->p_y[p_track->n - 1];
+    }
+
+    threads_run(track_total, tracks, sizeof(TS_Track), active);
+
+    /* Every block begins by the sum of previous blocks. */
+    for (t = 0; t < active; t++) {
+      TS_Csum total = tracks[t].sum;
+
+      tracks[t].sum = sum;
+      lbl_total(&sum, &total.hi, 1);
+      lbl_total(&sum, &total.lo, 1);
+    }
+
+    threads_run(track_scan, tracks, sizeof(TS_Track), active);
+
+    /* Writing of results in the input order. */
+    for (t = 0; t < active; t++) {
+      TS_Track *p_track = &tracks[t];
+
+      if (p_track->ret_val == EXIT_FAILURE
+          || outbuff_write(p_outbuff, p_track->outbuff.p_data,
+                           p_track->outbuff.used) == EXIT_FAILURE) {
+        err = (p_track->ret_val == EXIT_FAILURE) ? p_track->err : errno;
+        ret_val = EXIT_FAILURE;
+        eof = true;
+        break;
+      }
+
+      /* Warning upon wrong input, computation or reading error. */
+      if (print_warn == true && p_track->warn < p_track->n) {
+        size_t i = p_track->warn;
+        int err_val = (p_track->p_err[i] != 0) ? p_track->p_err[i]
+                                               : p_track->p_scan_err[i];
+
+        if (p_track->p_nan[i] == true)
+          fprintf(stderr, "proj2: warning: Some input values "
+                          "are not a number!\n");
+        else
+          fprintf(stderr, "proj2: warning: %s\n", strerror(err_val));
+
+        print_warn = false;
+      }
+    }
+  }
+
+  /* Dispose of blocks. */
+  for (t = 0; t < threads; t++)
+    track_free(&tracks[t]);
+
+  errno = err;
+
+  return ret_val;
+}
+
+
+/******************************************************************************
+ ~~~[ SUBSIDIARY FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/**
+ * Takes new chunk of whole values from given input buffer. If the buffer is
+ * memory-mapped, then the chunk is only the next part of it. Otherwise the
+ * part is copied into memory of the chunk, followed by the '\0' sentinel.
+ * Length of the chunk is 0 and p_eof is set to true upon end of input. Returns
+ * EXIT_FAILURE and sets errno upon error.
+ */
+static int chunk_read(TS_Chunk *p_chunk, TS_Inbuffer *p_inbuff, bool *p_eof)
+{
+  size_t length;                  /* Length of the part of input. */
+
+  errno = 0;
+
+  const char *p_part = inbuff_take(p_inbuff, CHUNK_SIZE, &length);
+
+  if (p_part == NULL) {
+    *p_eof = true;
+    p_chunk->length = 0;
+    return (errno != 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
+  p_chunk->length = length;
+
+  /* Mapped input stays in memory, no copying is needed. */
+  if (p_inbuff->mapped == true) {
+    p_chunk->p_values = p_part;
+    return EXIT_SUCCESS;
+  }
+
+  if (p_chunk->size < length + 1) {
+    char *p_new = (char *) realloc((void *) p_chunk->p_data,
+                                   (length + 1) * sizeof(char));
+
+    if (p_new == NULL) {
+      errno = ENOMEM;
+      return EXIT_FAILURE;
+    }
+
+    p_chunk->p_data = p_new;
+    p_chunk->size = length + 1;
+  }
+
+  memcpy(p_chunk->p_data, p_part, length);
+  p_chunk->p_data[length] = '\0';
+  p_chunk->p_values = p_chunk->p_data;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Thread function computing one chunk, which is given by p_arg pointer, into
+ * its' output buffer. It works the same way as func_w() function in proj2.c
+ * module, the result is stored in given chunk.
+ */
+static void *chunk_compute(void *p_arg)
+{
+  TS_Chunk *p_chunk = (TS_Chunk *) p_arg;
+
+  double x[CHUNK_BATCH];          /* Input values. */
+  double y[CHUNK_BATCH];          /* Results. */
+  int err[CHUNK_BATCH];           /* Errno values of results. */
+
+  TS_Inbuffer inbuff;             /* Input buffer over values of chunk. */
+
+  bool end = false;               /* Was the whole chunk read? */
+
+
+  inbuff_mem(&inbuff, p_chunk->p_values, p_chunk->length, p_chunk->format);
+
+  p_chunk->outbuff.used = 0;
+  p_chunk->warns = 0;
+  p_chunk->err = 0;
+  p_chunk->ret_val = EXIT_SUCCESS;
+
+  while (end == false) {
+    size_t n = 0;                 /* Number of read values. */
+    const double *p_x = x;        /* Values to compute. */
+
+    if (inbuff.format == FORMAT_F64) {
+      errno = 0;
+      n = breadf64_block(&inbuff, &p_x, x, CHUNK_BATCH);
+
+      if (n == 0) {
+        p_chunk->err = errno;     /* Incomplete value at the end of input. */
+        end = true;
+      }
+    }
+
+    /* Invalid text values are computed as NaN. */
+    while (inbuff.format == FORMAT_TEXT && n < CHUNK_BATCH) {
+      int scan_res = breadval(&inbuff, &x[n]);
+
+      if (scan_res == EOF) {
+        end = true;
+        break;
+      }
+
+      if (scan_res != 1) {
+        x[n] = NAN;
+        bskipval(&inbuff);
+      }
+
+      n++;
+    }
+
+    p_chunk->p_batch(p_x, y, err, n, p_chunk->sigdig);
+
+    for (size_t i = 0; i < n; i++) {
+      if (bwriteval(&p_chunk->outbuff, y[i]) == EXIT_FAILURE
+          || (err[i] != 0 && chunk_warn(p_chunk, err[i]) == EXIT_FAILURE)) {
+        p_chunk->err = errno;
+        p_chunk->ret_val = EXIT_FAILURE;
+        return NULL;
+      }
+    }
+  }
+
+  if (p_chunk->err != 0)
+    p_chunk->ret_val = EXIT_FAILURE;
+
+  return NULL;
+}
+
+
+/**
+ * Stores errno value of one result of the chunk, so the warning can be printed
+ * in the input order later. Returns EXIT_FAILURE and sets errno to ENOMEM, if
+ * the memory allocation has failed.
+ */
+static int chunk_warn(TS_Chunk *p_chunk, int err)
+{
+  if (p_chunk->warns == p_chunk->warn_size) {
+    size_t new_size = (p_chunk->warn_size == 0) ? CHUNK_BATCH
+                                                : 2 * p_chunk->warn_size;
+
+    int *p_new = (int *) realloc((void *) p_chunk->p_warn,
+                                 new_size * sizeof(int));
+
+    if (p_new == NULL) {
+      errno = ENOMEM;
+      return EXIT_FAILURE;
+    }
+
+    p_chunk->p_warn = p_new;
+    p_chunk->warn_size = new_size;
+  }
+
+  p_chunk->p_warn[p_chunk->warns++] = err;
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Initialization of the block of points of broken line, output is written in
+ * given format. Returns EXIT_FAILURE and sets errno to ENOMEM, if the memory
+ * allocation has failed.
+ */
+static int track_init(TS_Track *p_track, TE_Format format)
+{
+  p_track->p_x = (double *) malloc(TRACK_SIZE * sizeof(double));
+  p_track->p_y = (double *) malloc(TRACK_SIZE * sizeof(double));
+  p_track->p_len = (double *) malloc(TRACK_SIZE * sizeof(double));
+  p_track->p_err = (int *) malloc(TRACK_SIZE * sizeof(int));
+  p_track->p_scan_err = (int *) malloc(TRACK_SIZE * sizeof(int));
+  p_track->p_nan = (bool *) malloc(TRACK_SIZE * sizeof(bool));
+  p_track->n = 0;
+
+  if (p_track->p_x == NULL || p_track->p_y == NULL || p_track->p_len == NULL
+      || p_track->p_err == NULL || p_track->p_scan_err == NULL
+      || p_track->p_nan == NULL
+      || outbuff_init(&p_track->outbuff, NULL, format) == EXIT_FAILURE) {
+    track_free(p_track);
+    errno = ENOMEM;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ * Dispose of the block of points of broken line.
+ */
+static void track_free(TS_Track *p_track)
+{
+  free((void *) p_track->p_x);
+  free((void *) p_track->p_y);
+  free((void *) p_track->p_len);
+  free((void *) p_track->p_err);
+  free((void *) p_track->p_scan_err);
+  free((void *) p_track->p_nan);
+  outbuff_free(&p_track->outbuff);
+
+  return;
+}
+
+
+/**
+ * Thread function computing lengths of segments of one block of points, which
+ * is given by p_arg pointer, and their compensated sum.
+ */
+static void *track_total(void *p_arg)
+{
+  TS_Track *p_track = (TS_Track *) p_arg;
+
+  lbl_segments(&p_track->lobl, p_track->p_x, p_track->p_y, p_track->p_len,
+               p_track->p_err, p_track->n);
+
+  p_track->sum.hi = 0.0;
+  p_track->sum.lo = 0.0;
+
+  lbl_total(&p_track->sum, p_track->p_len, p_track->n);
+
+  return NULL;
+}
+
+
+/**
+ * Thread function computing sums after each point of one block of points,
+ * which is given by p_arg pointer, and writing them into its' output buffer.
+ * The first point with any warning is found too.
+ */
+static void *track_scan(void *p_arg)
+{
+  TS_Track *p_track = (TS_Track *) p_arg;
+
+  lbl_scan(&p_track->sum, p_track->p_len, p_track->p_len, p_track->p_err,
+           p_track->n);
+
+  p_track->outbuff.used = 0;
+  p_track->warn = p_track->n;
+  p_track->ret_val = EXIT_SUCCESS;
+
+  for (size_t i = 0; i < p_track->n; i++) {
+    if (bwriteval(&p_track->outbuff, p_track->p_len[i]) == EXIT_FAILURE) {
+      p_track->err = errno;
+      p_track->ret_val = EXIT_FAILURE;
+      return NULL;
+    }
+
+    if (p_track->warn == p_track->n
+        && (p_track->p_nan[i] == true || p_track->p_err[i] != 0
+            || p_track->p_scan_err[i] != 0)) {
+      p_track->warn = i;
+    }
+  }
+
+  return NULL;
+}
+
+
+/**
+ * Returns corrected number of threads, 0 stands for number of online
+ * processors and at most MAX_THREADS are used.
+ */
+static int threads_count(int threads)
+{
+  if (threads <= 0) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (online > 0) ? (int) online : 1;
+  }
+
+  return (threads > MAX_THREADS) ? MAX_THREADS : threads;
+}
+
+
+/**
+ * Calls given thread function for count items of given size from p_items
+ * field, every one in its' own thread, and waits for all of them. The item is
+ * processed by the calling thread, if the new thread can't start.
+ */
+static void threads_run(void *(*p_func)(void *), void *p_items,
+                        size_t item_size, int count)
+{
+  pthread_t tids[MAX_THREADS];    /* Identifiers of worker threads. */
+  bool started[MAX_THREADS];      /* Was the thread started? */
+
+  char *p_item = (char *) p_items;
+
+  for (int t = 0; t < count; t++) {
+    void *p_arg = (void *) (p_item + (size_t) t * item_size);
+
+    started[t] = (pthread_create(&tids[t], NULL, p_func, p_arg) == 0);
+
+    if (started[t] == false)
+      p_func(p_arg);
+  }
+
+  for (int t = 0; t < count; t++)
+    if (started[t] == true)
+      pthread_join(tids[t], NULL);
+
+  return;
+}
+
+
+/******************************************************************************
+ ***[ END OF PROJ2_PARALLEL.C ]************************************************
+ ******************************************************************************/
@@ -0,0 +1,69 @@
+/**
+ * File:          proj2_parallel.h
+ * Version:       1.0
+ * Date:          19-10-2026
+ * Last update:   19-10-2026
+ *
+ * Course:        IZP (winter semester, 2011)
+ * Project:       #2 - Iterative calculations
+ *
+ * Author:        David Kaspar (aka Dee'Kej), 1BIT
+ * Faculty:       Faculty of Information Technologies,
+ *                Brno University of Technologies
+ * E-mail:        xkaspa34@stud.fit.vutbr.cz
+ *
+ * Description:   This header file contains functional prototypes of functions
+ *                of proj2_parallel.c module, which computes the values of
+ *                input and the length of broken line by multiple threads.
+ * More info @:
+ *      https://www.fit.vutbr.cz/study/courses/IZP/private/projekty/proj2.html
+ *
+ * Encoding:      en_US.utf8 (United States)
+ * Compiler used: gcc 4.5.2 (Ubuntu/Linaro 4.5.2-8ubuntu4)
+ */
+
+/******************************************************************************
+ ***[ START OF PROJ2_PARALLEL.H ]**********************************************
+ ******************************************************************************/
+
+/*
+ * Safety mechanism against multiple including of this header file.
+ */
+#ifndef PROJ2_PARALLEL_H
+#define PROJ2_PARALLEL_H
+
+#include <stddef.h>
+
+#include "proj2_bufio.h"
+
+
+/******************************************************************************
+ ~~~[ GLOBAL CONSTANTS DEFINITIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+#define MAX_THREADS 64              /* Maximal number of worker threads. */
+
+
+/******************************************************************************
+ ~~~[ GLOBAL DATA TYPES DECLARATIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+/* Pointer to batch version of function of proj2_mathlib.c module. */
+typedef void (*TF_Batch)(const double *p_x, double *p_y, int *p_err, size_t n,
+                         int sigdig);
+
+
+/******************************************************************************
+ ~~~[ FUNCTIONAL PROTOTYPES OF GLOBAL FUNCTIONS ]~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ ******************************************************************************/
+
+int process_values_mt(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff,
+                      TF_Batch p_batch, int sigdig, int threads);
+int process_lbl_mt(TS_Inbuffer *p_inbuff, TS_Outbuffer *p_outbuff,
+                   int threads);
+
+#endif
+
+/******************************************************************************
+ ***[ END OF PROJ2_PARALLEL.H ]************************************************
+ ******************************************************************************/